@@ -326,10 +326,14 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.ready.document_store.cache.hit_rate.average"));
         metrics.add(new Metric("content.proton.documentdb.ready.document_store.cache.lookups.rate"));
         metrics.add(new Metric("content.proton.documentdb.ready.document_store.cache.invalidations.rate"));
+        metrics.add(new Metric("content.proton.documentdb.ready.document_store.cache.evictions.rate"));
+        metrics.add(new Metric("content.proton.documentdb.ready.document_store.cache.max_shard_memory_usage.average"));
         metrics.add(new Metric("content.proton.documentdb.notready.document_store.cache.memory_usage.average"));
         metrics.add(new Metric("content.proton.documentdb.notready.document_store.cache.hit_rate.average"));
         metrics.add(new Metric("content.proton.documentdb.notready.document_store.cache.lookups.rate"));
         metrics.add(new Metric("content.proton.documentdb.notready.document_store.cache.invalidations.rate"));
+        metrics.add(new Metric("content.proton.documentdb.notready.document_store.cache.evictions.rate"));
+        metrics.add(new Metric("content.proton.documentdb.notready.document_store.cache.max_shard_memory_usage.average"));
 
         // attribute
         metrics.add(new Metric("content.proton.documentdb.ready.attribute.memory_usage.allocated_bytes.average"));
@@ -350,6 +354,8 @@ public class VespaMetricSet {
         // matching
         metrics.add(new Metric("content.proton.documentdb.matching.queries.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.soft_doomed_queries.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.result_cache_hits.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.result_cache_misses.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.query_latency.average"));
         metrics.add(new Metric("content.proton.documentdb.matching.query_collateral_time.average"));
         metrics.add(new Metric("content.proton.documentdb.matching.docs_matched.rate"));
@@ -360,6 +366,8 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.docs_matched.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.limited_queries.rate"));
         metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.soft_doomed_queries.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.result_cache_hits.rate"));
+        metrics.add(new Metric("content.proton.documentdb.matching.rank_profile.result_cache_misses.rate"));
 
         return metrics;
     }
@@ -47,6 +47,7 @@ class DocumentSelectParserTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(test_function_call_on_doctype_throws_exception);
     CPPUNIT_TEST(test_parse_utilities_handle_well_formed_input);
     CPPUNIT_TEST(test_parse_utilities_handle_malformed_input);
+    CPPUNIT_TEST(test_constant_compare_operands_are_evaluated_once);
     CPPUNIT_TEST_SUITE_END();
 
     BucketIdFactory _bucketIdFactory;
@@ -113,6 +114,7 @@ public:
     void test_function_call_on_doctype_throws_exception();
     void test_parse_utilities_handle_well_formed_input();
     void test_parse_utilities_handle_malformed_input();
+    void test_constant_compare_operands_are_evaluated_once();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DocumentSelectParserTest);
@@ -1586,4 +1588,40 @@ void DocumentSelectParserTest::test_parse_utilities_handle_malformed_input() {
     check_parse_double("1.79769e+309", true, std::numeric_limits<double>::infinity());
 }
 
+void DocumentSelectParserTest::test_constant_compare_operands_are_evaluated_once() {
+    createDocs();
+    {
+        auto root = _parser->parse("1 + 2 == 3");
+        auto& cmp = dynamic_cast<const select::Compare&>(*root);
+        CPPUNIT_ASSERT(cmp.getLeft().isConstant());
+        CPPUNIT_ASSERT(cmp.getRight().isConstant());
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::True), root->contains(*_doc[0]));
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::True), root->contains(*_doc[1]));
+    }
+    {
+        auto root = _parser->parse("now() > 0");
+        auto& cmp = dynamic_cast<const select::Compare&>(*root);
+        CPPUNIT_ASSERT(!cmp.getLeft().isConstant());
+        CPPUNIT_ASSERT(cmp.getRight().isConstant());
+    }
+    // The same precompiled pattern must be matched against each document in turn.
+    {
+        auto root = _parser->parse("testdoctype1.hstringval =~ \"^(foo|bar)$\"");
+        auto& cmp = dynamic_cast<const select::Compare&>(*root);
+        CPPUNIT_ASSERT(!cmp.getLeft().isConstant());
+        CPPUNIT_ASSERT(cmp.getRight().isConstant());
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::True), root->contains(*_doc[0]));
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::True), root->contains(*_doc[1]));
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::False), root->contains(*_doc[2]));
+    }
+    {
+        auto root = _parser->parse("testdoctype1.hstringval = \"b?r\"");
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::False), root->contains(*_doc[0]));
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::True), root->contains(*_doc[1]));
+        auto cloned = root->clone();
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::False), cloned->contains(*_doc[0]));
+        CPPUNIT_ASSERT_EQUAL(select::ResultList(select::Result::True), cloned->contains(*_doc[1]));
+    }
+}
+
 } // document
@@ -7,6 +7,7 @@
 #include <vespa/document/datatype/datatype.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/util/stringutil.h>
+#include <vespa/vespalib/util/regexp.h>
 #include <ostream>
 
 namespace document {
@@ -20,8 +21,12 @@ Compare::Compare(std::unique_ptr<ValueNode> left,
       _left(std::move(left)),
       _right(std::move(right)),
       _operator(op),
-      _bucketIdFactory(bucketIdFactory)
+      _bucketIdFactory(bucketIdFactory),
+      _leftConstant(),
+      _rightConstant(),
+      _regex()
 {
+    precompute();
 }
 
 Compare::~Compare()
@@ -38,25 +43,34 @@ Node::UP Compare::clone() const
 
 namespace {
 
-    template<typename T>
-    ResultList containsValue(const T& value, const ValueNode& l, const ValueNode& r,
-                         const Operator& op)
+    std::unique_ptr<Value> evaluateConstant(const ValueNode& node)
     {
-        std::unique_ptr<Value> left(l.getValue(value));
-        std::unique_ptr<Value> right(r.getValue(value));
-        if (left->getType() == Value::Bucket
-            || right->getType() == Value::Bucket)
+        if (!node.isConstant()) {
+            return std::unique_ptr<Value>();
+        }
+        try {
+            return node.getValue(Context());
+        } catch (std::exception &) {
+            // Leave it to per document evaluation to fail the same way.
+            return std::unique_ptr<Value>();
+        }
+    }
+
+    ResultList compareValues(const Value& left, const Value& right, const Operator& op)
+    {
+        if (left.getType() == Value::Bucket
+            || right.getType() == Value::Bucket)
         {
-            Value& bVal(left->getType() == Value::Bucket ? *left : *right);
-            Value& nVal(left->getType() == Value::Bucket ? *right : *left);
+            const Value& bVal(left.getType() == Value::Bucket ? left : right);
+            const Value& nVal(left.getType() == Value::Bucket ? right : left);
             if (nVal.getType() == Value::Integer
                 && (op == FunctionOperator::EQ || op == FunctionOperator::NE
                     || op == GlobOperator::GLOB))
             {
                 document::BucketId b(
-                        static_cast<IntegerValue&>(bVal).getValue());
+                        static_cast<const IntegerValue&>(bVal).getValue());
                 document::BucketId s(
-                        static_cast<IntegerValue&>(nVal).getValue());
+                        static_cast<const IntegerValue&>(nVal).getValue());
 
                 ResultList resultList(Result::get(s.contains(b)));
 
@@ -68,7 +82,7 @@ namespace {
                 return ResultList(Result::Invalid);
             }
         }
-        return op.compare(*left, *right);
+        return op.compare(left, right);
     }
 
     template<typename T>
@@ -120,9 +134,38 @@ namespace {
     }
 }
 
+void
+Compare::precompute()
+{
+    _leftConstant = evaluateConstant(*_left);
+    _rightConstant = evaluateConstant(*_right);
+    if (!_rightConstant || _rightConstant->getType() != Value::String) {
+        return;
+    }
+    const vespalib::string& pattern(static_cast<const StringValue&>(*_rightConstant).getValue());
+    if (_operator == GlobOperator::GLOB) {
+        _regex = std::make_unique<vespalib::Regexp>(GlobOperator::GLOB.convertToRegex(pattern));
+    } else if (_operator == RegexOperator::REGEX && !pattern.empty()) {
+        _regex = std::make_unique<vespalib::Regexp>(pattern);
+    }
+}
+
 ResultList Compare::contains(const Context& context) const
 {
-    return containsValue<Context>(context, *_left, *_right, _operator);
+    std::unique_ptr<Value> left;
+    std::unique_ptr<Value> right;
+    if (!_leftConstant) {
+        left = _left->getValue(context);
+    }
+    if (!_rightConstant) {
+        right = _right->getValue(context);
+    }
+    const Value& lval(_leftConstant ? *_leftConstant : *left);
+    const Value& rval(_rightConstant ? *_rightConstant : *right);
+    if (_regex && (lval.getType() == Value::String)) {
+        return ResultList(Result::get(_regex->match(static_cast<const StringValue&>(lval).getValue())));
+    }
+    return compareValues(lval, rval, _operator);
 }
 
 ResultList Compare::trace(const Context& context, std::ostream& out) const
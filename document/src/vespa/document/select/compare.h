@@ -17,10 +17,13 @@
 #include "operator.h"
 #include <vespa/document/bucket/bucketidfactory.h>
 
+namespace vespalib { class Regexp; }
+
 namespace document {
 namespace select {
 
 class ValueNode;
+class Value;
 
 class Compare : public Node
 {
@@ -29,8 +32,14 @@ private:
     std::unique_ptr<ValueNode> _right;
     const Operator& _operator;
     const BucketIdFactory& _bucketIdFactory;
+    // Values of constant operands and the compiled pattern of a regex or
+    // glob compare against a constant string, computed once at construction.
+    std::unique_ptr<Value> _leftConstant;
+    std::unique_ptr<Value> _rightConstant;
+    std::unique_ptr<vespalib::Regexp> _regex;
 
     bool isLeafNode() const override { return false; }
+    void precompute();
 public:
     Compare(std::unique_ptr<ValueNode> left, const Operator& op,
             std::unique_ptr<ValueNode> right,
@@ -35,6 +35,12 @@ public:
     virtual void visit(Visitor&) const = 0;
     virtual ValueNode::UP clone() const = 0;
     virtual std::unique_ptr<Value> traceValue(const Context &context, std::ostream &out) const;
+    /**
+     * Returns true if the value of this node does not depend on the
+     * context it is evaluated in, such that it can be evaluated once
+     * up front instead of for every document.
+     */
+    virtual bool isConstant() const { return false; }
 private:
     bool _parentheses; // Set to true if parentheses was used around this part
                        // Set such that we can recreate original query in print.
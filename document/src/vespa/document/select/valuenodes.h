@@ -24,6 +24,7 @@ public:
     std::unique_ptr<Value> getValue(const Context&) const override {
         return std::unique_ptr<Value>(new InvalidValue());
     }
+    bool isConstant() const override { return true; }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& visitor) const override;
@@ -41,6 +42,7 @@ public:
     std::unique_ptr<Value> getValue(const Context&) const override {
         return std::unique_ptr<Value>(new NullValue());
     }
+    bool isConstant() const override { return true; }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
 
@@ -62,6 +64,7 @@ public:
     std::unique_ptr<Value> getValue(const Context&) const override {
         return std::unique_ptr<Value>(new StringValue(_value));
     }
+    bool isConstant() const override { return true; }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& visitor) const override;
@@ -84,6 +87,7 @@ public:
     virtual std::unique_ptr<Value> getValue(const Context&) const override {
         return std::unique_ptr<Value>(new IntegerValue(_value, _isBucketValue));
     }
+    bool isConstant() const override { return true; }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& visitor) const override;
@@ -139,6 +143,7 @@ public:
     std::unique_ptr<Value> getValue(const Context&) const override {
         return std::unique_ptr<Value>(new FloatValue(_value));
     }
+    bool isConstant() const override { return true; }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& visitor) const override;
@@ -292,6 +297,7 @@ public:
     std::unique_ptr<Value> traceValue(const Context &context, std::ostream& out) const override {
         return traceValue(_source->getValue(context), out);
     }
+    bool isConstant() const override { return _source->isConstant(); }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& visitor) const override;
@@ -333,6 +339,7 @@ public:
     traceValue(const Context &context, std::ostream& out) const override {
         return traceValue(_left->getValue(context), _right->getValue(context), out);
     }
+    bool isConstant() const override { return _left->isConstant() && _right->isConstant(); }
 
     void print(std::ostream& out, bool verbose, const std::string& indent) const override;
     void visit(Visitor& visitor) const override;
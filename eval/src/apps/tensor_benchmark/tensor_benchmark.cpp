@@ -0,0 +1,206 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/node_types.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/slime/json_format.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cstdlib>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::slime::convenience;
+using slime::JsonFormat;
+using tensor::DefaultTensorEngine;
+
+//-----------------------------------------------------------------------------
+
+// How the dimensions of the benchmarked tensors are represented
+enum class Kind { DENSE, SPARSE, MIXED };
+
+const char *kind_name(Kind kind) {
+    switch (kind) {
+    case Kind::DENSE:  return "dense";
+    case Kind::SPARSE: return "sparse";
+    case Kind::MIXED:  return "mixed";
+    }
+    return "unknown";
+}
+
+// Dimension 'x' is mapped for mixed tensors, all others are indexed.
+// This depends on the name only, so that a dimension shared between
+// parameters gets the same representation in all of them.
+bool is_mapped(Kind kind, const vespalib::string &dim) {
+    return ((kind == Kind::SPARSE) || ((kind == Kind::MIXED) && (dim == "x")));
+}
+
+// Make a tensor spanning the given dimensions with 'size' labels each
+TensorSpec make_spec(Kind kind, const std::vector<vespalib::string> &dims, size_t size) {
+    std::vector<ValueType::Dimension> type_dims;
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (is_mapped(kind, dims[i])) {
+            type_dims.emplace_back(dims[i]);
+        } else {
+            type_dims.emplace_back(dims[i], size);
+        }
+    }
+    TensorSpec spec(ValueType::tensor_type(type_dims).to_spec());
+    size_t num_cells = 1;
+    for (size_t i = 0; i < dims.size(); ++i) {
+        num_cells *= size;
+    }
+    for (size_t cell = 0; cell < num_cells; ++cell) {
+        TensorSpec::Address address;
+        size_t rest = cell;
+        for (size_t i = dims.size(); i-- > 0; rest /= size) {
+            size_t idx = (rest % size);
+            if (is_mapped(kind, dims[i])) {
+                address.emplace(dims[i], TensorSpec::Label(make_string("%zu", idx)));
+            } else {
+                address.emplace(dims[i], TensorSpec::Label(idx));
+            }
+        }
+        spec.add(address, double(cell % 17) / 8.0);
+    }
+    return spec;
+}
+
+//-----------------------------------------------------------------------------
+
+// A benchmarked expression with the dimensions of each parameter
+struct Case {
+    vespalib::string name;
+    vespalib::string expression;
+    std::vector<std::vector<vespalib::string>> params;
+};
+
+std::vector<Case> make_cases() {
+    std::vector<vespalib::string> xy({"x", "y"});
+    std::vector<vespalib::string> yz({"y", "z"});
+    return {
+        {"map",        "map(a,f(v)(v*2+1))",   {xy}},
+        {"join",       "a*b",                  {xy, xy}},
+        {"reduce_all", "reduce(a,sum)",        {xy}},
+        {"reduce_dim", "reduce(a,sum,y)",      {xy}},
+        {"dot_product","reduce(a*b,sum)",      {xy, xy}},
+        {"concat",     "concat(a,b,z)",        {xy, xy}},
+        {"rename",     "rename(a,y,z)",        {xy}},
+        {"matmul",     "reduce(a*b,sum,y)",    {xy, yz}}
+    };
+}
+
+//-----------------------------------------------------------------------------
+
+// Compiles an expression for a single engine and measures how long it
+// takes to evaluate it with the given parameters.
+struct Evaluation {
+    const TensorEngine &engine;
+    Function function;
+    std::vector<Value::UP> values;
+    std::vector<Value::CREF> refs;
+    std::unique_ptr<NodeTypes> types;
+    std::unique_ptr<InterpretedFunction> ifun;
+
+    Evaluation(const TensorEngine &engine_in, const vespalib::string &expr, const std::vector<TensorSpec> &specs)
+        : engine(engine_in), function(Function::parse(expr)), values(), refs(), types(), ifun()
+    {
+        std::vector<ValueType> param_types;
+        for (const TensorSpec &spec: specs) {
+            values.push_back(engine.from_spec(spec));
+            refs.emplace_back(*values.back());
+            param_types.push_back(values.back()->type());
+        }
+        types = std::make_unique<NodeTypes>(function, param_types);
+        if (types->get_type(function.root()).is_error()) {
+            fprintf(stderr, "type error in benchmarked expression: %s\n", expr.c_str());
+            abort();
+        }
+        ifun = std::make_unique<InterpretedFunction>(engine, function, *types);
+    }
+    TensorSpec result() const {
+        InterpretedFunction::Context ctx(*ifun);
+        SimpleObjectParams params(refs);
+        return engine.to_spec(ifun->eval(ctx, params));
+    }
+    double estimate_us(double budget) const {
+        InterpretedFunction::Context ctx(*ifun);
+        SimpleObjectParams params(refs);
+        auto eval = [&](){ ifun->eval(ctx, params); };
+        auto baseline = [&](){ (void) ctx; (void) params; };
+        return BenchmarkTimer::benchmark(eval, baseline, budget) * 1000.0 * 1000.0;
+    }
+};
+
+void run_case(const Case &c, Kind kind, size_t size, double budget, Cursor &results) {
+    std::vector<TensorSpec> specs;
+    for (const auto &dims: c.params) {
+        specs.push_back(make_spec(kind, dims, size));
+    }
+    Evaluation simple(SimpleTensorEngine::ref(), c.expression, specs);
+    Evaluation prod(DefaultTensorEngine::ref(), c.expression, specs);
+    Cursor &result = results.addObject();
+    result.setString("case", c.name);
+    result.setString("expression", c.expression);
+    result.setString("kind", kind_name(kind));
+    result.setLong("size", size);
+    Cursor &params = result.setObject("params");
+    for (size_t i = 0; i < specs.size(); ++i) {
+        params.setString(simple.function.param_name(i), specs[i].type());
+    }
+    result.setString("result_type", simple.types->get_type(simple.function.root()).to_spec());
+    double simple_us = simple.estimate_us(budget);
+    double prod_us = prod.estimate_us(budget);
+    result.setBool("match", (simple.result() == prod.result()));
+    result.setDouble("simple_us", simple_us);
+    result.setDouble("prod_us", prod_us);
+    fprintf(stderr, "%-12s %-7s size %4zu: simple %12.3f us, prod %12.3f us\n",
+            c.name.c_str(), kind_name(kind), size, simple_us, prod_us);
+}
+
+//-----------------------------------------------------------------------------
+
+int usage(const char *self) {
+    fprintf(stderr, "usage: %s [budget] [case]\n", self);
+    fprintf(stderr, "  benchmark tensor operations using both the reference and the\n");
+    fprintf(stderr, "  production tensor engine for dense, sparse and mixed tensors\n");
+    fprintf(stderr, "  of various sizes. Results are written to stdout as json.\n");
+    fprintf(stderr, "  [budget]: seconds spent measuring each evaluation (default 0.25)\n");
+    fprintf(stderr, "  [case]: only run the case with this name (default all)\n");
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 3) {
+        return usage(argv[0]);
+    }
+    double budget = (argc > 1) ? strtod(argv[1], nullptr) : 0.25;
+    vespalib::string only = (argc > 2) ? argv[2] : "";
+    if (budget <= 0.0) {
+        return usage(argv[0]);
+    }
+    Slime slime;
+    Cursor &top = slime.setObject();
+    top.setDouble("budget", budget);
+    Cursor &results = top.setArray("results");
+    for (const Case &c: make_cases()) {
+        if (!only.empty() && (c.name != only)) {
+            continue;
+        }
+        for (Kind kind: {Kind::DENSE, Kind::SPARSE, Kind::MIXED}) {
+            for (size_t size: {4, 16, 64}) {
+                run_case(c, kind, size, budget, results);
+            }
+        }
+    }
+    SimpleBuffer buf;
+    JsonFormat::encode(slime, buf, false);
+    fwrite(buf.get().data, 1, buf.get().size, stdout);
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/eval/eval/key_gen.h>
 #include <vespa/eval/eval/test/eval_spec.h>
+#include <vespa/vespalib/io/fileutil.h>
 #include <set>
 
 using namespace vespalib::eval;
@@ -144,6 +145,66 @@ TEST("require that cache usage works") {
     TEST_DO(verify_cache(0, 0));
 }
 
+TEST("require that compiled object code can be stored on disk and reused") {
+    vespalib::string dir("object_cache_dir");
+    vespalib::rmdir(dir, true);
+    ASSERT_TRUE(vespalib::mkdir(dir));
+    CompileCache::set_object_cache_dir(dir, 1024 * 1024);
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("x*y+3"), PassParams::SEPARATE);
+        EXPECT_EQUAL(9.0, token->get().get_function<2>()(2.0, 3.0));
+    }
+    EXPECT_EQUAL(0u, CompileCache::get_object_cache_stats().loaded);
+    EXPECT_EQUAL(1u, CompileCache::get_object_cache_stats().stored);
+    EXPECT_EQUAL(1u, vespalib::listDirectory(dir).size());
+    {
+        // no code is generated when the object is loaded from disk
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("x*y+3"), PassParams::SEPARATE);
+        EXPECT_EQUAL(15.0, token->get().get_function<2>()(3.0, 4.0));
+    }
+    EXPECT_EQUAL(1u, CompileCache::get_object_cache_stats().loaded);
+    EXPECT_EQUAL(1u, CompileCache::get_object_cache_stats().stored);
+    EXPECT_EQUAL(1u, vespalib::listDirectory(dir).size());
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("x*y+4"), PassParams::SEPARATE);
+        EXPECT_EQUAL(10.0, token->get().get_function<2>()(2.0, 3.0));
+    }
+    EXPECT_EQUAL(1u, CompileCache::get_object_cache_stats().loaded);
+    EXPECT_EQUAL(2u, CompileCache::get_object_cache_stats().stored);
+    EXPECT_EQUAL(2u, vespalib::listDirectory(dir).size());
+    size_t size = CompileCache::get_object_cache_stats().size;
+    EXPECT_GREATER(size, 0u);
+    CompileCache::set_object_cache_dir(dir, size);
+    EXPECT_EQUAL(size, CompileCache::get_object_cache_stats().size);
+    EXPECT_EQUAL(2u, vespalib::listDirectory(dir).size());
+    CompileCache::set_object_cache_dir("", 0);
+    vespalib::rmdir(dir, true);
+}
+
+TEST("require that the object cache directory is kept within its size limit") {
+    vespalib::string dir("object_cache_dir");
+    vespalib::rmdir(dir, true);
+    ASSERT_TRUE(vespalib::mkdir(dir));
+    CompileCache::set_object_cache_dir(dir, 1024 * 1024);
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("x*y+5"), PassParams::SEPARATE);
+    }
+    size_t size = CompileCache::get_object_cache_stats().size;
+    ASSERT_GREATER(size, 0u);
+    CompileCache::set_object_cache_dir(dir, size - 1);
+    EXPECT_EQUAL(0u, CompileCache::get_object_cache_stats().size);
+    EXPECT_EQUAL(0u, vespalib::listDirectory(dir).size());
+    {
+        CompileCache::Token::UP token = CompileCache::compile(Function::parse("x*y+5"), PassParams::SEPARATE);
+        EXPECT_EQUAL(11.0, token->get().get_function<2>()(2.0, 3.0));
+    }
+    EXPECT_EQUAL(0u, CompileCache::get_object_cache_stats().loaded);
+    EXPECT_EQUAL(0u, CompileCache::get_object_cache_stats().stored);
+    EXPECT_EQUAL(0u, vespalib::listDirectory(dir).size());
+    CompileCache::set_object_cache_dir("", 0);
+    vespalib::rmdir(dir, true);
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -283,6 +283,27 @@ TEST("require that models with too large sets are rejected by general vm optimiz
     EXPECT_TRUE(!Optimize::apply_chain(general_vm_chain, stats, trees).valid());
 }
 
+TEST("require that VM forests can be evaluated for a batch of documents") {
+    Function function = Function::parse(Model().less_percent(80).make_forest(300, 30));
+    size_t num_params = function.num_params();
+    size_t num_docs = 100;
+    std::vector<double> params;
+    for (size_t doc = 0; doc < num_docs; ++doc) {
+        for (size_t i = 0; i < num_params; ++i) {
+            params.push_back(double((doc * 7 + i * 3) % 11) / 10.0);
+        }
+    }
+    for (const auto &chain: {general_vm_chain, Optimize::none}) {
+        CompiledFunction compiled_function(function, PassParams::ARRAY, chain);
+        auto f = compiled_function.get_function();
+        std::vector<double> results(num_docs, -1.0);
+        compiled_function.eval_batch(&params[0], num_docs, &results[0]);
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            EXPECT_EQUAL(f(&params[doc * num_params]), results[doc]);
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 double eval_compiled(const CompiledFunction &cfun, std::vector<double> &params) {
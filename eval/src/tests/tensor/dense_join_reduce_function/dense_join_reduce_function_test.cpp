@@ -0,0 +1,78 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_join_reduce_function.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+using namespace vespalib::eval::tensor_function;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("a", spec(1.5))
+        .add("x3", spec({x(3)}, N()))
+        .add("x3y2", spec({x(3),y(2)}, N()))
+        .add("y2z4", spec({y(2),z(4)}, Div10(N())))
+        .add("x3z4", spec({x(3),z(4)}, Sub2(N())))
+        .add("x3_u", spec({x(3)}, N()), "tensor(x[])")
+        .add("x_m", spec({x({"a", "b", "c"})}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, Aggr aggr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<DenseJoinReduceFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    EXPECT_TRUE(info[0]->result_is_mutable());
+    EXPECT_EQUAL(int(info[0]->aggr()), int(aggr));
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<DenseJoinReduceFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST("require that join with lambda followed by reduce is fused") {
+    TEST_DO(verify_optimized("reduce(join(x3y2,y2z4,f(a,b)(a*b+1)),sum,y)", Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(join(x3y2,y2z4,f(a,b)(a-b)),sum)", Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(join(x3y2,x3z4,f(a,b)(max(a,b))),max,x,z)", Aggr::MAX));
+}
+
+TEST("require that all join functions can be fused") {
+    TEST_DO(verify_optimized("reduce(x3y2+y2z4,min,y)", Aggr::MIN));
+    TEST_DO(verify_optimized("reduce(x3y2*x3,prod,x)", Aggr::PROD));
+}
+
+TEST("require that unsupported aggregators are not fused") {
+    TEST_DO(verify_not_optimized("reduce(x3y2*y2z4,avg,y)"));
+    TEST_DO(verify_not_optimized("reduce(x3y2*y2z4,count,y)"));
+}
+
+TEST("require that non-dense and abstract tensors are not fused") {
+    TEST_DO(verify_not_optimized("reduce(x3y2*a,sum,y)"));
+    TEST_DO(verify_not_optimized("reduce(x3_u*x3y2,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(x_m*x_m,sum,x)"));
+}
+
+TEST("require that dot products are not fused") {
+    TEST_DO(verify_not_optimized("reduce(x3*x3,sum)"));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
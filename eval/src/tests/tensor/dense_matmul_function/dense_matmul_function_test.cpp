@@ -0,0 +1,93 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_matmul_function.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+using namespace vespalib::eval::tensor_function;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+struct MyMatSeq : Sequence {
+    double operator[](size_t i) const override { return (5.0 + i) * 43.0; }
+};
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("x2y3", spec({x(2),y(3)}, MyMatSeq()))
+        .add("x2z3", spec({x(2),z(3)}, MyMatSeq()))
+        .add("y3z4", spec({y(3),z(4)}, MyMatSeq()))
+        .add("x2z4", spec({x(2),z(4)}, MyMatSeq()))
+        .add("y4z3", spec({y(4),z(3)}, MyMatSeq()))
+        .add("y100z5", spec({y(100),z(5)}, MyMatSeq()))
+        .add("x3y100", spec({x(3),y(100)}, MyMatSeq()))
+        .add("y3", spec({y(3)}, MyMatSeq()))
+        .add("x2y3_u", spec({x(2),y(3)}, MyMatSeq()), "tensor(x[2],y[])")
+        .add("x2y3z4", spec({x(2),y(3),z(4)}, MyMatSeq()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t lhs_size, size_t common_size, size_t rhs_size,
+                      bool lhs_inner, bool rhs_inner)
+{
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<DenseMatMulFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    EXPECT_TRUE(info[0]->result_is_mutable());
+    EXPECT_EQUAL(info[0]->lhs_size(), lhs_size);
+    EXPECT_EQUAL(info[0]->common_size(), common_size);
+    EXPECT_EQUAL(info[0]->rhs_size(), rhs_size);
+    EXPECT_EQUAL(info[0]->lhs_common_inner(), lhs_inner);
+    EXPECT_EQUAL(info[0]->rhs_common_inner(), rhs_inner);
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<DenseMatMulFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST("require that matrix multiplication gives same results as reference join/reduce") {
+    TEST_DO(verify_optimized("reduce(x2y3*y3z4,sum,y)", 2, 3, 4, true, false));
+    TEST_DO(verify_optimized("reduce(y3z4*x2y3,sum,y)", 2, 3, 4, true, false));
+    TEST_DO(verify_optimized("reduce(x2y3*x2z3,sum,x)", 3, 2, 3, false, false));
+    TEST_DO(verify_optimized("reduce(x2z3*y4z3,sum,z)", 2, 3, 4, true, true));
+    TEST_DO(verify_optimized("reduce(y4z3*x2z3,sum,z)", 2, 3, 4, true, true));
+}
+
+TEST("require that large matrix multiplication gives same results as reference join/reduce") {
+    TEST_DO(verify_optimized("reduce(x3y100*y100z5,sum,y)", 3, 100, 5, true, false));
+}
+
+TEST("require that other join/reduce combinations are not optimized as matrix multiplication") {
+    TEST_DO(verify_not_optimized("reduce(x2y3*y3z4,max,y)"));
+    TEST_DO(verify_not_optimized("reduce(x2y3+y3z4,sum,y)"));
+    TEST_DO(verify_not_optimized("reduce(x2y3*y3z4,sum,y,z)"));
+    TEST_DO(verify_not_optimized("reduce(x2y3*y3,sum,y)"));
+    TEST_DO(verify_not_optimized("reduce(x2y3_u*y3z4,sum,y)"));
+    TEST_DO(verify_not_optimized("reduce(x2y3*x2y3z4,sum,y)"));
+}
+
+TEST("require that bias and activation can be applied to the matrix multiplication result") {
+    vespalib::string expr = "map(reduce(x2y3*y3z4,sum,y)+x2z4,f(a)(max(a,0)))";
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_EQUAL(fixture.find_all<DenseMatMulFunction>().size(), 1u);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,99 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/vespalib/objects/nbostream.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("y3", spec({y(3)}, N()))
+        .add("z2", spec({z(2)}, N()))
+        .add("x_m", spec({x({"a", "b", "c"})}, N()))
+        .add("z_m", spec({z({"a", "b"})}, N()))
+        .add("x_my3", spec({x({"a", "b", "c"}),y(3)}, N()))
+        .add("x_my3_2", spec({x({"b", "c", "d"}),y(3)}, Div10(N())))
+        .add("x_mz_my3", spec({x({"a", "b"}),z({"c", "d"}),y(3)}, N()))
+        .add("z_my3", spec({z({"a", "b"}),y(3)}, N()))
+        .add("x_my3z2", spec({x({"a", "b", "c"}),y(3),z(2)}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, false, false);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+}
+
+TEST("require that mixed tensors are created from spec") {
+    TensorSpec expect = spec({x({"a", "b"}),y(3)}, N());
+    auto value = prod_engine.from_spec(expect);
+    auto tensor = dynamic_cast<const MixedTensor *>(value->as_tensor());
+    ASSERT_TRUE(tensor != nullptr);
+    EXPECT_EQUAL(tensor->index().size(), 2u);
+    EXPECT_EQUAL(tensor->dense_size(), 3u);
+    EXPECT_EQUAL(prod_engine.to_spec(*value), expect);
+}
+
+TEST("require that mixed tensors can be mapped") {
+    TEST_DO(verify("map(x_my3,f(a)(a*10))"));
+    TEST_DO(verify("map(x_my3z2,f(a)(a-5))"));
+}
+
+TEST("require that mixed tensors can be joined with numbers") {
+    TEST_DO(verify("x_my3+5"));
+    TEST_DO(verify("5*x_my3"));
+}
+
+TEST("require that mixed tensors can be joined with mixed tensors") {
+    TEST_DO(verify("x_my3*x_my3"));
+    TEST_DO(verify("x_my3*x_my3_2"));
+    TEST_DO(verify("x_my3*z_my3"));
+    TEST_DO(verify("x_mz_my3+x_my3"));
+}
+
+TEST("require that mixed tensors can be joined with sparse and dense tensors") {
+    TEST_DO(verify("x_my3*x_m"));
+    TEST_DO(verify("x_my3*z_m"));
+    TEST_DO(verify("x_my3*y3"));
+    TEST_DO(verify("x_my3*z2"));
+    TEST_DO(verify("x_m*z2"));
+}
+
+TEST("require that mixed tensors can be reduced") {
+    TEST_DO(verify("reduce(x_my3,sum)"));
+    TEST_DO(verify("reduce(x_my3,sum,x)"));
+    TEST_DO(verify("reduce(x_my3,max,y)"));
+    TEST_DO(verify("reduce(x_my3z2,prod,y)"));
+    TEST_DO(verify("reduce(x_my3z2,min,x,z)"));
+    TEST_DO(verify("reduce(x_mz_my3,sum,z)"));
+    TEST_DO(verify("reduce(x_mz_my3,avg,z)"));
+}
+
+TEST("require that mixed tensor binary format is compatible with simple tensor") {
+    TensorSpec expect = spec({x({"a", "b", "c"}),y(3),z(2)}, N());
+    auto value = prod_engine.from_spec(expect);
+    nbostream prod_data;
+    prod_engine.encode(*value, prod_data);
+    nbostream simple_data;
+    SimpleTensor::encode(*SimpleTensor::create(expect), simple_data);
+    ASSERT_EQUAL(prod_data.size(), simple_data.size());
+    EXPECT_EQUAL(memcmp(prod_data.peek(), simple_data.peek(), prod_data.size()), 0);
+    auto decoded = prod_engine.decode(prod_data);
+    EXPECT_TRUE(dynamic_cast<const MixedTensor *>(decoded->as_tensor()) != nullptr);
+    EXPECT_EQUAL(prod_engine.to_spec(*decoded), expect);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,66 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_sorted_cells.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("x", spec({x({"a", "b", "c", "d"})}, N()))
+        .add("x_2", spec({x({"b", "d", "e"})}, Div10(N())))
+        .add("xy", spec({x({"a", "b", "c"}),y({"1", "2", "3"})}, N()))
+        .add("xy_2", spec({x({"b", "c", "d"}),y({"2", "3", "4"})}, Sub2(N())))
+        .add("yz", spec({y({"1", "3", "5"}),z({"p", "q"})}, Div10(N())))
+        .add("z", spec({z({"p", "q", "r"})}, Sub2(N())))
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, false);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+}
+
+TEST("require that tensors with the same dimensions can be joined with any function") {
+    TEST_DO(verify("x*x_2"));
+    TEST_DO(verify("x-x_2"));
+    TEST_DO(verify("x_2-x"));
+    TEST_DO(verify("xy+xy_2"));
+    TEST_DO(verify("join(xy_2,xy,f(a,b)(a/b))"));
+}
+
+TEST("require that tensors with partially overlapping dimensions are merge-joined") {
+    TEST_DO(verify("xy*yz"));
+    TEST_DO(verify("yz-xy"));
+    TEST_DO(verify("x_2+xy_2"));
+    TEST_DO(verify("join(xy,x_2,f(a,b)(a-b))"));
+}
+
+TEST("require that tensors without common dimensions are joined as cartesian product") {
+    TEST_DO(verify("x-z"));
+    TEST_DO(verify("z*xy"));
+}
+
+TEST("require that sorted cells are grouped by labels of common dimensions") {
+    auto value = prod_engine.from_spec(spec({x({"a", "b"}),y({"1", "2", "3"})}, N()));
+    const auto &tensor = dynamic_cast<const SparseTensor &>(*value->as_tensor());
+    sparse::SortedCells cells(tensor, ValueType::from_spec("tensor(y{},z{})"));
+    size_t groups = 0;
+    for (auto itr = cells.begin(); itr != cells.end(); itr = cells.groupEnd(itr)) {
+        EXPECT_EQUAL(cells.groupEnd(itr) - itr, 2);
+        ++groups;
+    }
+    EXPECT_EQUAL(groups, 3u);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
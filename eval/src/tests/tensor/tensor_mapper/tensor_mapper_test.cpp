@@ -3,6 +3,7 @@
 #include <vespa/eval/eval/simple_tensor.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
 #include <vespa/eval/tensor/tensor_mapper.h>
 #include <vespa/eval/tensor/test/test_utils.h>
 #include <vespa/eval/tensor/wrapped_simple_tensor.h>
@@ -33,6 +34,7 @@ verify(const TensorSpec &source, const vespalib::string &type, const TensorSpec
     auto mapped = mapper.map(*tensor);
     TensorSpec actual = mapped->toSpec();
     EXPECT_EQUAL(actual, expect);
+    EXPECT_EQUAL(MixedTensor::is_mixed(mapped->type()), (dynamic_cast<const MixedTensor *>(mapped.get()) != nullptr));
     TEST_DO(verify_wrapped(source, type, expect));
 }
 
@@ -216,6 +218,21 @@ TEST("require that sparse tensors can be mapped to mixed type") {
                    .add({{"x",1},{"y","1"}}, 7)));
 }
 
+TEST("require that tensors mapped to mixed type use the mixed tensor implementation") {
+    auto tensor = makeTensor<Tensor>(TensorSpec("tensor(x{},y{})")
+                                     .add({{"x","0"},{"y","a"}}, 1)
+                                     .add({{"x","1"},{"y","b"}}, 2));
+    TensorMapper mapper(ValueType::from_spec("tensor(x[2],y{})"));
+    auto mapped = mapper.map(*tensor);
+    ASSERT_TRUE(dynamic_cast<const MixedTensor *>(mapped.get()) != nullptr);
+    EXPECT_EQUAL(mapped->toSpec(),
+                 TensorSpec("tensor(x[2],y{})")
+                 .add({{"x",0},{"y","a"}}, 1)
+                 .add({{"x",1},{"y","a"}}, 0)
+                 .add({{"x",0},{"y","b"}}, 0)
+                 .add({{"x",1},{"y","b"}}, 2));
+}
+
 TEST("require that missing dimensions are added appropriately") {
     TEST_DO(verify(TensorSpec("tensor(x{})")
                    .add({{"x","foo"}}, 42),
@@ -143,6 +143,19 @@ TEST_F("test tensor serialization for SparseTensor", SparseFixture)
     testTensorSerialization(f);
 }
 
+TEST("require that sparse tensor labels are reordered to sorted dimension order") {
+    nbostream stream;
+    ExpBuffer buf({ 0x01, 0x02, 0x01, 0x79, 0x01, 0x78, 0x01, 0x01,
+                    0x34, 0x01, 0x32, 0x40, 0x08, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00 });
+    stream.write(&buf[0], buf.size());
+    auto tensor = TypedBinaryFormat::deserialize(stream);
+    EXPECT_EQUAL(0u, stream.size());
+    SparseTensorBuilder builder;
+    auto expect = TensorFactory::create({ {{{"x","2"}, {"y", "4"}}, 3} }, { "x", "y" }, builder);
+    EXPECT_EQUAL(*expect, *tensor);
+    EXPECT_EQUAL(expect->toSpec(), tensor->toSpec());
+}
 
 struct DenseFixture
 {
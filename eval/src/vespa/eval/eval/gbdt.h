@@ -80,6 +80,13 @@ bool contains_gbdt(const nodes::Node &node, size_t limit);
 struct Forest {
     using UP = std::unique_ptr<Forest>;
     using eval_function = double (*)(const Forest *self, const double *args);
+    /**
+     * Evaluate the forest for a batch of documents. The parameters
+     * for each document are stored back to back in 'args', with
+     * 'num_args' parameters per document. Returns false if batch
+     * evaluation is not supported by this forest.
+     **/
+    virtual bool eval_batch(const double *, size_t, size_t, double *) const { return false; }
     virtual ~Forest() {}
 };
 
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "compile_cache.h"
+#include "llvm_wrapper.h"
 #include <vespa/eval/eval/key_gen.h>
 #include <thread>
 
@@ -47,6 +48,18 @@ CompileCache::count_refs()
     return refs;
 }
 
+void
+CompileCache::set_object_cache_dir(const vespalib::string &dir, size_t max_size)
+{
+    LLVMWrapper::set_object_cache_dir(dir, max_size);
+}
+
+ObjectCacheStats
+CompileCache::get_object_cache_stats()
+{
+    return LLVMWrapper::get_object_cache_stats();
+}
+
 void
 CompileCache::do_compile(CompileContext &ctx) {
     vespalib::string key = gen_key(ctx.function, ctx.pass_params);
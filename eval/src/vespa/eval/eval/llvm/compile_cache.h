@@ -48,6 +48,16 @@ public:
     static size_t num_cached();
     static size_t count_refs();
 
+    /**
+     * Use the given directory to keep generated object code across
+     * processes. Functions with forests or set membership tests are
+     * never stored, since their code refers to process local data.
+     * An empty string disables the persistent cache. The objects
+     * kept in the directory use at most 'max_size' bytes.
+     **/
+    static void set_object_cache_dir(const vespalib::string &dir, size_t max_size);
+    static ObjectCacheStats get_object_cache_stats();
+
 private:
     struct CompileContext {
         const Function &function;
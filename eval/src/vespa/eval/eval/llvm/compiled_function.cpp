@@ -36,7 +36,8 @@ CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_
     : _llvm_wrapper(),
       _address(nullptr),
       _num_params(function_in.num_params()),
-      _pass_params(pass_params_in)
+      _pass_params(pass_params_in),
+      _batch_forest(nullptr)
 {
     size_t id = _llvm_wrapper.make_function(function_in.num_params(),
                                             _pass_params,
@@ -44,15 +45,35 @@ CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_
                                             forest_optimizers);
     _llvm_wrapper.compile();
     _address = _llvm_wrapper.get_function_address(id);
+    // a forest at the root is optimized as a whole or not at all
+    if ((_pass_params == PassParams::ARRAY) && function_in.root().is_forest() &&
+        (_llvm_wrapper.get_forests().size() == 1))
+    {
+        _batch_forest = _llvm_wrapper.get_forests()[0].get();
+    }
 }
 
 CompiledFunction::CompiledFunction(CompiledFunction &&rhs)
     : _llvm_wrapper(std::move(rhs._llvm_wrapper)),
       _address(rhs._address),
       _num_params(rhs._num_params),
-      _pass_params(rhs._pass_params)
+      _pass_params(rhs._pass_params),
+      _batch_forest(rhs._batch_forest)
 {
     rhs._address = nullptr;
+    rhs._batch_forest = nullptr;
+}
+
+void
+CompiledFunction::eval_batch(const double *params, size_t num_docs, double *results) const
+{
+    if ((_batch_forest != nullptr) && _batch_forest->eval_batch(params, _num_params, num_docs, results)) {
+        return;
+    }
+    auto function = get_function();
+    for (size_t i = 0; i < num_docs; ++i) {
+        results[i] = function(params + (i * _num_params));
+    }
 }
 
 double
@@ -35,6 +35,7 @@ private:
     void       *_address;
     size_t      _num_params;
     PassParams  _pass_params;
+    const gbdt::Forest *_batch_forest;
 
 public:
     typedef std::unique_ptr<CompiledFunction> UP;
@@ -62,6 +63,13 @@ public:
     const std::vector<gbdt::Forest::UP> &get_forests() const {
         return _llvm_wrapper.get_forests();
     }
+    /**
+     * Evaluate an ARRAY function for a batch of documents, with the
+     * parameters for each document stored back to back. Functions
+     * consisting of a single optimized GBDT forest are evaluated
+     * tree by tree across the documents when the forest supports it.
+     **/
+    void eval_batch(const double *params, size_t num_docs, double *results) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
     static Function::Issues detect_issues(const Function &function);
     static bool should_use_lazy_params(const Function &function);
@@ -14,9 +14,22 @@
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/LinkAllPasses.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <vespa/eval/eval/check_type.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/approx.h>
+#include <algorithm>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".eval.eval.llvm.llvm_wrapper");
 
 double vespalib_eval_ldexp(double a, double b) { return std::ldexp(a, b); }
 double vespalib_eval_min(double a, double b) { return std::min(a, b); }
@@ -601,6 +614,140 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
 
 FunctionBuilder::~FunctionBuilder() { }
 
+/**
+ * Settings and statistics for the on-disk object cache, protected
+ * by the global llvm lock.
+ **/
+struct ObjectCacheState {
+    vespalib::string dir;
+    size_t max_size;
+    ObjectCacheStats stats;
+    ObjectCacheState() : dir(), max_size(0), stats() {}
+};
+
+ObjectCacheState object_cache_state;
+
+struct ObjectFile {
+    vespalib::string name;
+    time_t modified;
+    size_t size;
+    bool operator<(const ObjectFile &rhs) const { return (modified < rhs.modified); }
+};
+
+// Remove left-over temporary files and the oldest objects until the
+// objects in the directory use at most 'max_size' bytes. Returns the
+// number of bytes used by the remaining objects.
+size_t trim_object_cache_dir(const vespalib::string &dir, size_t max_size) {
+    std::vector<ObjectFile> files;
+    size_t size = 0;
+    DIR *dirp = opendir(dir.c_str());
+    if (dirp == nullptr) {
+        LOG(warning, "could not list object cache directory '%s'", dir.c_str());
+        return size;
+    }
+    while (struct dirent *entry = readdir(dirp)) {
+        vespalib::string name = dir + "/" + entry->d_name;
+        struct stat info;
+        if ((stat(name.c_str(), &info) != 0) || !S_ISREG(info.st_mode)) {
+            continue;
+        }
+        if (ends_with(name, ".tmp")) {
+            unlink(name.c_str());
+        } else if (ends_with(name, ".o")) {
+            files.push_back(ObjectFile{name, info.st_mtime, size_t(info.st_size)});
+            size += info.st_size;
+        }
+    }
+    closedir(dirp);
+    std::sort(files.begin(), files.end());
+    for (size_t i = 0; (i < files.size()) && (size > max_size); ++i) {
+        if (unlink(files[i].name.c_str()) == 0) {
+            size -= files[i].size;
+        }
+    }
+    return size;
+}
+
+/**
+ * Object cache storing generated object code in a directory, one
+ * file per module. The module identifier is used as file name and
+ * must uniquely identify the generated code. Must be used while
+ * holding the global llvm lock.
+ **/
+class DiskObjectCache : public llvm::ObjectCache
+{
+private:
+    ObjectCacheState &_state;
+
+    vespalib::string file_name(const llvm::Module *module) const {
+        return _state.dir + "/" + module->getModuleIdentifier() + ".o";
+    }
+
+public:
+    explicit DiskObjectCache(ObjectCacheState &state) : _state(state) {}
+
+    void notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef obj) override {
+        size_t obj_size = obj.getBufferSize();
+        if ((_state.stats.size + obj_size) > _state.max_size) {
+            return;
+        }
+        vespalib::string name = file_name(module);
+        vespalib::string tmp_name = vespalib::make_string("%s.%d.tmp", name.c_str(), getpid());
+        std::error_code error;
+        {
+            llvm::raw_fd_ostream out(tmp_name.c_str(), error, llvm::sys::fs::F_None);
+            if (!error) {
+                out << obj.getBuffer();
+                out.close();
+                // the stream aborts on destruction with unhandled errors
+                if (out.has_error()) {
+                    out.clear_error();
+                    error = std::make_error_code(std::errc::io_error);
+                }
+            }
+        }
+        if (!error) {
+            error = llvm::sys::fs::rename(tmp_name.c_str(), name.c_str());
+        }
+        if (error) {
+            LOG(warning, "could not store compiled object code in '%s': %s",
+                name.c_str(), error.message().c_str());
+            llvm::sys::fs::remove(tmp_name.c_str());
+            return;
+        }
+        _state.stats.size += obj_size;
+        ++_state.stats.stored;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *module) override {
+        auto buffer = llvm::MemoryBuffer::getFile(file_name(module).c_str());
+        if (!buffer) {
+            return nullptr;
+        }
+        ++_state.stats.loaded;
+        return llvm::MemoryBuffer::getMemBufferCopy((*buffer)->getBuffer());
+    }
+};
+
+// Calculate a module identifier from the generated code and
+// everything else affecting the machine code produced for it.
+vespalib::string make_object_key(const llvm::Module &module) {
+    std::string ir;
+    llvm::raw_string_ostream ir_stream(ir);
+    module.print(ir_stream, nullptr);
+    ir_stream.flush();
+    llvm::MD5 md5;
+    md5.update(ir);
+    md5.update(LLVM_VERSION_STRING);
+    md5.update(llvm::sys::getProcessTriple());
+    md5.update(llvm::sys::getHostCPUName());
+    llvm::MD5::MD5Result result;
+    md5.final(result);
+    llvm::SmallString<32> hex;
+    llvm::MD5::stringifyResult(result, hex);
+    return vespalib::string(hex.c_str());
+}
+
 } // namespace vespalib::eval::<unnamed>
 
 struct InitializeNativeTarget {
@@ -672,9 +819,41 @@ LLVMWrapper::compile(llvm::raw_ostream * dumpStream)
     if (dumpStream) {
         _module->print(*dumpStream, nullptr);
     }
+    // Code referring to forests or plugin state embeds their addresses
+    // in this process, and cannot be reused by other processes.
+    std::unique_ptr<DiskObjectCache> object_cache;
+    if (!object_cache_state.dir.empty() && _forests.empty() && _plugin_state.empty()) {
+        _module->setModuleIdentifier(make_object_key(*_module).c_str());
+        object_cache = std::make_unique<DiskObjectCache>(object_cache_state);
+    }
     _engine.reset(llvm::EngineBuilder(std::move(_module)).setOptLevel(llvm::CodeGenOpt::Aggressive).create());
     assert(_engine && "llvm jit not available for your platform");
+    if (object_cache) {
+        _engine->setObjectCache(object_cache.get());
+    }
     _engine->finalizeObject();
+    if (object_cache) {
+        _engine->setObjectCache(nullptr);
+    }
+}
+
+void
+LLVMWrapper::set_object_cache_dir(const vespalib::string &dir, size_t max_size)
+{
+    std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
+    object_cache_state.dir = dir;
+    object_cache_state.max_size = max_size;
+    object_cache_state.stats = ObjectCacheStats();
+    if (!dir.empty()) {
+        object_cache_state.stats.size = trim_object_cache_dir(dir, max_size);
+    }
+}
+
+ObjectCacheStats
+LLVMWrapper::get_object_cache_stats()
+{
+    std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
+    return object_cache_state.stats;
 }
 
 void *
@@ -35,6 +35,16 @@ struct PluginState {
     virtual ~PluginState() {}
 };
 
+/**
+ * Statistics for the on-disk cache of generated object code.
+ **/
+struct ObjectCacheStats {
+    size_t loaded; // objects read from disk instead of generating code
+    size_t stored; // objects written to disk after generating code
+    size_t size;   // bytes used by objects in the cache directory
+    ObjectCacheStats() : loaded(0), stored(0), size(0) {}
+};
+
 /**
  * Stuff related to LLVM code generation is wrapped in this
  * class. This is mostly used by the CompiledFunction class.
@@ -63,6 +73,17 @@ public:
     void compile(llvm::raw_ostream & dumpStream) { compile(&dumpStream); }
     void compile() { compile(nullptr); }
     void *get_function_address(size_t function_id);
+
+    /**
+     * Store generated object code in the given directory, and reuse
+     * it instead of generating code again for identical modules,
+     * also across processes. An empty string disables the cache.
+     * Objects in the directory are removed, oldest first, until
+     * their total size is within 'max_size' bytes. New objects are
+     * not stored when that would exceed 'max_size' bytes.
+     **/
+    static void set_object_cache_dir(const vespalib::string &dir, size_t max_size);
+    static ObjectCacheStats get_object_cache_stats();
     ~LLVMWrapper();
 };
 
@@ -5,6 +5,7 @@
 #include <vespa/eval/eval/basic_nodes.h>
 #include <vespa/eval/eval/call_nodes.h>
 #include <vespa/eval/eval/operator_nodes.h>
+#include <algorithm>
 
 namespace vespalib {
 namespace eval {
@@ -14,6 +15,9 @@ namespace {
 
 //-----------------------------------------------------------------------------
 
+// number of documents evaluated together for each tree in batch mode
+constexpr size_t BATCH_BLOCK_SIZE = 64;
+
 constexpr uint32_t LEAF = 0; 
 constexpr uint32_t LESS = 1; 
 constexpr uint32_t IN   = 2; 
@@ -238,6 +242,29 @@ VMForest::general_eval(const Forest *forest, const double *input)
     return sum;
 }
 
+bool
+VMForest::eval_batch(const double *args, size_t num_args, size_t num_docs, double *results) const
+{
+    // Visit all documents in a block for each tree before moving on
+    // to the next tree, so that each tree is read from memory once
+    // per block instead of once per document.
+    const uint32_t *begin = &_model[0];
+    const uint32_t *end = begin + _model.size();
+    for (size_t first = 0; first < num_docs; first += BATCH_BLOCK_SIZE) {
+        size_t block_end = std::min(first + BATCH_BLOCK_SIZE, num_docs);
+        std::fill(results + first, results + block_end, 0.0);
+        for (const uint32_t *pos = begin; pos < end; ) {
+            uint32_t tree_size = *pos++;
+            uint32_t node_type = (*pos & 0xf00) >> 8;
+            for (size_t doc = first; doc < block_end; ++doc) {
+                results[doc] += general_find_leaf(args + (doc * num_args), pos, node_type);
+            }
+            pos += tree_size;
+        }
+    }
+    return true;
+}
+
 Optimize::Chain VMForest::optimize_chain({less_only_optimize, general_optimize});
 
 //-----------------------------------------------------------------------------
@@ -26,6 +26,7 @@ public:
     static Optimize::Result general_optimize(const ForestStats &stats,
                                              const std::vector<const nodes::Node *> &trees);
     static double general_eval(const Forest *forest, const double *);
+    bool eval_batch(const double *args, size_t num_args, size_t num_docs, double *results) const override;
     static Optimize::Chain optimize_chain;
 };
 
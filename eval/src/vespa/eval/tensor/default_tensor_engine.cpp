@@ -14,7 +14,10 @@
 #include "dense/dense_remove_dimension_optimizer.h"
 #include "dense/dense_inplace_join_function.h"
 #include "dense/dense_inplace_map_function.h"
+#include "dense/dense_join_reduce_function.h"
+#include "dense/dense_matmul_function.h"
 #include "dense/vector_from_doubles_function.h"
+#include "mixed/mixed_tensor.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/tensor_spec.h>
@@ -64,11 +67,6 @@ const Value &to_simple(const Value &value, Stash &stash) {
 
 const Value &to_default(const Value &value, Stash &stash) {
     if (auto tensor = value.as_tensor()) {
-        if (auto simple = dynamic_cast<const eval::SimpleTensor *>(tensor)) {
-            if (!Tensor::supported({simple->type()})) {
-                return stash.create<WrappedSimpleTensor>(*simple);
-            }
-        }
         nbostream data;
         tensor->engine().encode(*tensor, data);
         return *stash.create<Value::UP>(default_engine().decode(data));
@@ -104,6 +102,10 @@ const Value &fallback_reduce(const Value &a, eval::Aggr aggr, const std::vector<
     return to_default(simple_engine().reduce(to_simple(a, stash), aggr, dimensions, stash), stash);
 }
 
+bool is_mixed(const tensor::Tensor &tensor) {
+    return (dynamic_cast<const MixedTensor *>(&tensor) != nullptr);
+}
+
 } // namespace vespalib::tensor::<unnamed>
 
 const DefaultTensorEngine DefaultTensorEngine::_engine;
@@ -137,7 +139,7 @@ DefaultTensorEngine::from_spec(const TensorSpec &spec) const
         }
     }
     if (is_dense && is_sparse) {
-        return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::create(spec));
+        return MixedTensor::create(spec);
     } else if (is_dense) {
         DenseTensorBuilder builder;
         std::map<vespalib::string,DenseTensorBuilder::Dimension> dimension_map;
@@ -230,6 +232,8 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
         child.set(VectorFromDoublesFunction::optimize(child.get(), stash));
         child.set(DenseDotProductFunction::optimize(child.get(), stash));
         child.set(DenseXWProductFunction::optimize(child.get(), stash));
+        child.set(DenseMatMulFunction::optimize(child.get(), stash));
+        child.set(DenseJoinReduceFunction::optimize(child.get(), stash));
         child.set(DenseFastRenameOptimizer::optimize(child.get(), stash));
         child.set(DenseAddDimensionOptimizer::optimize(child.get(), stash));
         child.set(DenseRemoveDimensionOptimizer::optimize(child.get(), stash));
@@ -251,7 +255,7 @@ DefaultTensorEngine::map(const Value &a, map_fun_t function, Stash &stash) const
     } else if (auto tensor = a.as_tensor()) {
         assert(&tensor->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor);
-        if (!tensor::Tensor::supported({my_a.type()})) {
+        if (!tensor::Tensor::supported({my_a.type()}) && !is_mixed(my_a)) {
             return to_default(simple_engine().map(to_simple(a, stash), function, stash), stash);
         }
         CellFunctionFunAdapter cell_function(function);
@@ -270,7 +274,7 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         } else if (auto tensor_b = b.as_tensor()) {
             assert(&tensor_b->engine() == this);
             const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
-            if (!tensor::Tensor::supported({my_b.type()})) {
+            if (!tensor::Tensor::supported({my_b.type()}) && !is_mixed(my_b)) {
                 return fallback_join(a, b, function, stash);
             }
             CellFunctionBindLeftAdapter cell_function(function, a.as_double());
@@ -282,7 +286,7 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
         assert(&tensor_a->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor_a);
         if (b.is_double()) {
-            if (!tensor::Tensor::supported({my_a.type()})) {
+            if (!tensor::Tensor::supported({my_a.type()}) && !is_mixed(my_a)) {
                 return fallback_join(a, b, function, stash);
             }
             CellFunctionBindRightAdapter cell_function(function, b.as_double());
@@ -291,6 +295,9 @@ DefaultTensorEngine::join(const Value &a, const Value &b, join_fun_t function, S
             assert(&tensor_b->engine() == this);
             const tensor::Tensor &my_b = static_cast<const tensor::Tensor &>(*tensor_b);
             if (!tensor::Tensor::supported({my_a.type(), my_b.type()})) {
+                if (auto result = MixedTensor::join(function, my_a, my_b)) {
+                    return to_value(std::move(result), stash);
+                }
                 return fallback_join(a, b, function, stash);
             }
             return to_value(my_a.join(function, my_b), stash);
@@ -316,7 +323,7 @@ DefaultTensorEngine::reduce(const Value &a, Aggr aggr, const std::vector<vespali
     } else if (auto tensor = a.as_tensor()) {
         assert(&tensor->engine() == this);
         const tensor::Tensor &my_a = static_cast<const tensor::Tensor &>(*tensor);
-        if (!tensor::Tensor::supported({my_a.type()})) {
+        if (!tensor::Tensor::supported({my_a.type()}) && !is_mixed(my_a)) {
             return fallback_reduce(a, aggr, dimensions, stash);
         }
         switch (aggr) {
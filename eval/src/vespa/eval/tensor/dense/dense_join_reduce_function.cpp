@@ -0,0 +1,177 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_join_reduce_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/visit_stuff.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+
+namespace vespalib::tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using eval::Aggr;
+using eval::TensorFunction;
+using eval::Value;
+using eval::ValueType;
+using eval::as;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+namespace {
+
+CellsRef getCellsRef(const Value &value) {
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+bool isConcreteDenseTensor(const ValueType &type) {
+    return (type.is_dense() && !type.is_abstract());
+}
+
+join_fun_t aggrFunction(Aggr aggr) {
+    switch (aggr) {
+    case Aggr::PROD: return Mul::f;
+    case Aggr::SUM:  return Add::f;
+    case Aggr::MAX:  return Max::f;
+    case Aggr::MIN:  return Min::f;
+    default:         return nullptr;
+    }
+}
+
+// the distance between cells along each dimension in 'space' for
+// the cells of 'type'; 0 for dimensions not in 'type'
+std::vector<size_t> stridesFor(const ValueType &type, const ValueType &space) {
+    std::vector<size_t> strides(space.dimensions().size(), 0);
+    size_t stride = 1;
+    for (size_t i = type.dimensions().size(); i-- > 0; ) {
+        size_t idx = space.dimension_index(type.dimensions()[i].name);
+        if (idx != ValueType::Dimension::npos) {
+            strides[idx] = stride;
+        }
+        stride *= type.dimensions()[i].size;
+    }
+    return strides;
+}
+
+void my_join_reduce_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const auto &self = *((const DenseJoinReduceFunction::Self *)(param));
+    const double *lhs = getCellsRef(state.peek(1)).cbegin();
+    const double *rhs = getCellsRef(state.peek(0)).cbegin();
+    ArrayRef<double> dst = state.stash.create_array<double>(self.result_size);
+    const size_t num_dims = self.sizes.size();
+    ArrayRef<size_t> idx = state.stash.create_array<size_t>(num_dims);
+    size_t lhs_offset = 0;
+    size_t rhs_offset = 0;
+    size_t dst_offset = 0;
+    size_t reduce_offset = 0;
+    for (bool done = false; !done; ) {
+        double value = self.function(lhs[lhs_offset], rhs[rhs_offset]);
+        double &cell = dst[dst_offset];
+        cell = (reduce_offset == 0) ? value : self.aggr_function(cell, value);
+        done = true;
+        for (size_t d = num_dims; d-- > 0; ) {
+            lhs_offset += self.lhs_strides[d];
+            rhs_offset += self.rhs_strides[d];
+            dst_offset += self.result_strides[d];
+            reduce_offset += self.reduce_strides[d];
+            if (++idx[d] < self.sizes[d]) {
+                done = false;
+                break;
+            }
+            lhs_offset -= self.lhs_strides[d] * idx[d];
+            rhs_offset -= self.rhs_strides[d] * idx[d];
+            dst_offset -= self.result_strides[d] * idx[d];
+            reduce_offset -= self.reduce_strides[d] * idx[d];
+            idx[d] = 0;
+        }
+    }
+    if (self.result_type.is_double()) {
+        state.pop_pop_push(state.stash.create<eval::DoubleValue>(dst[0]));
+    } else {
+        state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, dst));
+    }
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+DenseJoinReduceFunction::Self::Self(const ValueType &result_type_in, join_fun_t function_in, join_fun_t aggr_function_in)
+    : result_type(result_type_in),
+      function(function_in),
+      aggr_function(aggr_function_in),
+      result_size(1),
+      sizes(),
+      lhs_strides(),
+      rhs_strides(),
+      result_strides(),
+      reduce_strides()
+{
+    for (const auto &dim : result_type.dimensions()) {
+        result_size *= dim.size;
+    }
+}
+
+DenseJoinReduceFunction::Self::~Self() = default;
+
+DenseJoinReduceFunction::DenseJoinReduceFunction(const ValueType &result_type,
+                                                 const ValueType &join_type,
+                                                 const TensorFunction &lhs,
+                                                 const TensorFunction &rhs,
+                                                 join_fun_t function_in,
+                                                 Aggr aggr_in)
+    : Super(result_type, lhs, rhs),
+      _join_type(join_type),
+      _function(function_in),
+      _aggr(aggr_in)
+{
+}
+
+DenseJoinReduceFunction::~DenseJoinReduceFunction() = default;
+
+eval::InterpretedFunction::Instruction
+DenseJoinReduceFunction::compile_self(Stash &stash) const
+{
+    Self &self = stash.create<Self>(result_type(), _function, aggrFunction(_aggr));
+    for (const auto &dim : _join_type.dimensions()) {
+        self.sizes.push_back(dim.size);
+        bool kept = (result_type().dimension_index(dim.name) != ValueType::Dimension::npos);
+        self.reduce_strides.push_back(kept ? 0 : 1);
+    }
+    self.lhs_strides = stridesFor(lhs().result_type(), _join_type);
+    self.rhs_strides = stridesFor(rhs().result_type(), _join_type);
+    self.result_strides = stridesFor(result_type(), _join_type);
+    return eval::InterpretedFunction::Instruction(my_join_reduce_op, (uint64_t)(&self));
+}
+
+void
+DenseJoinReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    ::visit(visitor, "function", _function);
+    ::visit(visitor, "aggr", _aggr);
+}
+
+const TensorFunction &
+DenseJoinReduceFunction::optimize(const TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && (aggrFunction(reduce->aggr()) != nullptr)) {
+        auto join = as<Join>(reduce->child());
+        if (join) {
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            const ValueType &res = reduce->result_type();
+            if (isConcreteDenseTensor(lhs.result_type()) &&
+                isConcreteDenseTensor(rhs.result_type()) &&
+                isConcreteDenseTensor(join->result_type()) &&
+                (res.is_double() || isConcreteDenseTensor(res)))
+            {
+                return stash.create<DenseJoinReduceFunction>(res, join->result_type(), lhs, rhs,
+                                                             join->function(), reduce->aggr());
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
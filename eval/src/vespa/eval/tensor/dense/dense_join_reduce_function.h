@@ -0,0 +1,59 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function fusing a join of two concrete dense tensors with a
+ * reduce of the join result. Each cell of the (never materialized)
+ * join result is calculated with the join function, which is machine
+ * code compiled by LLVM for lambdas, and aggregated directly into the
+ * result. The cell offsets are tracked with strides calculated once
+ * from the tensor types when the function is compiled.
+ */
+class DenseJoinReduceFunction : public eval::tensor_function::Op2
+{
+    using Super = eval::tensor_function::Op2;
+public:
+    using join_fun_t = eval::tensor_function::join_fun_t;
+
+    struct Self {
+        eval::ValueType     result_type;
+        join_fun_t          function;
+        join_fun_t          aggr_function;
+        size_t              result_size;
+        std::vector<size_t> sizes;
+        std::vector<size_t> lhs_strides;
+        std::vector<size_t> rhs_strides;
+        std::vector<size_t> result_strides;
+        std::vector<size_t> reduce_strides;
+        Self(const eval::ValueType &result_type_in, join_fun_t function_in, join_fun_t aggr_function_in);
+        ~Self();
+    };
+
+private:
+    eval::ValueType _join_type;
+    join_fun_t      _function;
+    eval::Aggr      _aggr;
+
+public:
+    DenseJoinReduceFunction(const eval::ValueType &result_type,
+                            const eval::ValueType &join_type,
+                            const eval::TensorFunction &lhs,
+                            const eval::TensorFunction &rhs,
+                            join_fun_t function_in,
+                            eval::Aggr aggr_in);
+    ~DenseJoinReduceFunction();
+    const eval::ValueType &join_type() const { return _join_type; }
+    join_fun_t function() const { return _function; }
+    eval::Aggr aggr() const { return _aggr; }
+    bool result_is_mutable() const override { return true; }
+    eval::InterpretedFunction::Instruction compile_self(Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
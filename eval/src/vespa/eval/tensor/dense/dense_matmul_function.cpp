@@ -0,0 +1,201 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_matmul_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/operation.h>
+#include <cassert>
+
+namespace vespalib::tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using eval::ValueType;
+using eval::TensorFunction;
+using eval::as;
+using eval::Aggr;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+namespace {
+
+// number of common dimension cells handled together when the rhs
+// matrix has the common dimension outermost
+constexpr size_t COMMON_BLOCK_SIZE = 64;
+
+CellsRef getCellsRef(const eval::Value &value) {
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+// each result cell is a dot product of one lhs row and one rhs row
+template <bool lhs_common_inner>
+void dotProductRows(const DenseMatMulFunction::Self &self, const double *lhs, const double *rhs, double *dst) {
+    for (size_t i = 0; i < self.lhs_size; ++i) {
+        for (size_t j = 0; j < self.rhs_size; ++j) {
+            const double *rhsRow = rhs + (j * self.common_size);
+            if (lhs_common_inner) {
+                *dst++ = self.hw_accelerator->dotProduct(lhs + (i * self.common_size), rhsRow, self.common_size);
+            } else {
+                double cell = 0.0;
+                for (size_t k = 0; k < self.common_size; ++k) {
+                    cell += lhs[(k * self.lhs_size) + i] * rhsRow[k];
+                }
+                *dst++ = cell;
+            }
+        }
+    }
+}
+
+// each result row is accumulated from scaled rhs rows, processing
+// the common dimension in blocks to keep the rhs rows in cache
+template <bool lhs_common_inner>
+void accumulateRows(const DenseMatMulFunction::Self &self, const double *lhs, const double *rhs, double *dst) {
+    std::fill(dst, dst + (self.lhs_size * self.rhs_size), 0.0);
+    for (size_t block = 0; block < self.common_size; block += COMMON_BLOCK_SIZE) {
+        size_t blockEnd = std::min(block + COMMON_BLOCK_SIZE, self.common_size);
+        for (size_t i = 0; i < self.lhs_size; ++i) {
+            double *dstRow = dst + (i * self.rhs_size);
+            for (size_t k = block; k < blockEnd; ++k) {
+                double lhsCell = lhs_common_inner ? lhs[(i * self.common_size) + k] : lhs[(k * self.lhs_size) + i];
+                const double *rhsRow = rhs + (k * self.rhs_size);
+                for (size_t j = 0; j < self.rhs_size; ++j) {
+                    dstRow[j] += lhsCell * rhsRow[j];
+                }
+            }
+        }
+    }
+}
+
+template <bool lhs_common_inner, bool rhs_common_inner>
+void my_matmul_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const DenseMatMulFunction::Self &self = *((const DenseMatMulFunction::Self *)(param));
+    CellsRef lhsCells = getCellsRef(state.peek(1));
+    CellsRef rhsCells = getCellsRef(state.peek(0));
+    assert(lhsCells.size() == (self.lhs_size * self.common_size));
+    assert(rhsCells.size() == (self.rhs_size * self.common_size));
+    ArrayRef<double> dst = state.stash.create_array<double>(self.lhs_size * self.rhs_size);
+    if (rhs_common_inner) {
+        dotProductRows<lhs_common_inner>(self, lhsCells.cbegin(), rhsCells.cbegin(), dst.begin());
+    } else {
+        accumulateRows<lhs_common_inner>(self, lhsCells.cbegin(), rhsCells.cbegin(), dst.begin());
+    }
+    state.pop_pop_push(state.stash.create<DenseTensorView>(self.result_type, dst));
+}
+
+template <bool lhs_common_inner>
+eval::InterpretedFunction::op_function my_select(bool rhs_common_inner) {
+    return rhs_common_inner ? my_matmul_op<lhs_common_inner, true> : my_matmul_op<lhs_common_inner, false>;
+}
+
+bool isConcreteDenseTensor(const ValueType &type, size_t d) {
+    return (type.is_dense() && (type.dimensions().size() == d) && !type.is_abstract());
+}
+
+// lhs contributes result dimension 0, rhs result dimension 1
+bool isDenseMatMul(const ValueType &res, const ValueType &lhs, const ValueType &rhs, const vespalib::string &common) {
+    if (isConcreteDenseTensor(res, 2) && isConcreteDenseTensor(lhs, 2) && isConcreteDenseTensor(rhs, 2)) {
+        size_t npos = ValueType::Dimension::npos;
+        size_t lhs_common = lhs.dimension_index(common);
+        size_t rhs_common = rhs.dimension_index(common);
+        size_t lhs_res = lhs.dimension_index(res.dimensions()[0].name);
+        size_t rhs_res = rhs.dimension_index(res.dimensions()[1].name);
+        if ((lhs_common != npos) && (rhs_common != npos) && (lhs_res != npos) && (rhs_res != npos) &&
+            (lhs_common != lhs_res) && (rhs_common != rhs_res))
+        {
+            return ((lhs.dimensions()[lhs_common].size == rhs.dimensions()[rhs_common].size) &&
+                    (lhs.dimensions()[lhs_res].size == res.dimensions()[0].size) &&
+                    (rhs.dimensions()[rhs_res].size == res.dimensions()[1].size));
+        }
+    }
+    return false;
+}
+
+const TensorFunction &createDenseMatMul(const ValueType &res, const TensorFunction &lhs, const TensorFunction &rhs,
+                                        const vespalib::string &common, Stash &stash)
+{
+    const ValueType &lhs_type = lhs.result_type();
+    const ValueType &rhs_type = rhs.result_type();
+    return stash.create<DenseMatMulFunction>(res, lhs, rhs,
+                                             res.dimensions()[0].size,
+                                             lhs_type.dimensions()[lhs_type.dimension_index(common)].size,
+                                             res.dimensions()[1].size,
+                                             (lhs_type.dimension_index(common) == 1),
+                                             (rhs_type.dimension_index(common) == 1));
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+DenseMatMulFunction::Self::Self(const eval::ValueType &result_type_in, size_t lhs_size_in,
+                                size_t common_size_in, size_t rhs_size_in)
+    : result_type(result_type_in),
+      lhs_size(lhs_size_in),
+      common_size(common_size_in),
+      rhs_size(rhs_size_in),
+      hw_accelerator(hwaccelrated::IAccelrated::getAccelrator())
+{
+}
+
+DenseMatMulFunction::Self::~Self() = default;
+
+DenseMatMulFunction::DenseMatMulFunction(const eval::ValueType &result_type,
+                                         const eval::TensorFunction &lhs_in,
+                                         const eval::TensorFunction &rhs_in,
+                                         size_t lhs_size,
+                                         size_t common_size,
+                                         size_t rhs_size,
+                                         bool lhs_common_inner,
+                                         bool rhs_common_inner)
+    : Super(result_type, lhs_in, rhs_in),
+      _lhs_size(lhs_size),
+      _common_size(common_size),
+      _rhs_size(rhs_size),
+      _lhs_common_inner(lhs_common_inner),
+      _rhs_common_inner(rhs_common_inner)
+{
+}
+
+DenseMatMulFunction::~DenseMatMulFunction() = default;
+
+eval::InterpretedFunction::Instruction
+DenseMatMulFunction::compile_self(Stash &stash) const
+{
+    Self &self = stash.create<Self>(result_type(), _lhs_size, _common_size, _rhs_size);
+    auto op = _lhs_common_inner ? my_select<true>(_rhs_common_inner) : my_select<false>(_rhs_common_inner);
+    return eval::InterpretedFunction::Instruction(op, (uint64_t)(&self));
+}
+
+void
+DenseMatMulFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    visitor.visitInt("lhs_size", _lhs_size);
+    visitor.visitInt("common_size", _common_size);
+    visitor.visitInt("rhs_size", _rhs_size);
+    visitor.visitBool("lhs_common_inner", _lhs_common_inner);
+    visitor.visitBool("rhs_common_inner", _rhs_common_inner);
+}
+
+const TensorFunction &
+DenseMatMulFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && (reduce->aggr() == Aggr::SUM) && (reduce->dimensions().size() == 1)) {
+        auto join = as<Join>(reduce->child());
+        if (join && (join->function() == Mul::f)) {
+            const ValueType &res = reduce->result_type();
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            const vespalib::string &common = reduce->dimensions()[0];
+            if (isDenseMatMul(res, lhs.result_type(), rhs.result_type(), common)) {
+                return createDenseMatMul(res, lhs, rhs, common, stash);
+            }
+            if (isDenseMatMul(res, rhs.result_type(), lhs.result_type(), common)) {
+                return createDenseMatMul(res, rhs, lhs, common, stash);
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
@@ -0,0 +1,473 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_tensor.h"
+#include "mixed_tensor_builder.h"
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_combiner.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_decoder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_reducer.h>
+#include <vespa/eval/tensor/tensor_address_builder.h>
+#include <vespa/eval/tensor/tensor_visitor.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <cassert>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".eval.tensor.mixed.mixed_tensor");
+
+using vespalib::eval::TensorSpec;
+using vespalib::eval::ValueType;
+
+namespace vespalib::tensor {
+
+namespace {
+
+ValueType
+makeValueType(std::vector<ValueType::Dimension> &&dimensions)
+{
+    return (dimensions.empty() ?
+            ValueType::double_type() :
+            ValueType::tensor_type(std::move(dimensions)));
+}
+
+/**
+ * The subspaces of a mixed, sparse or dense tensor, seen as mapped
+ * addresses with a block of dense cells each. A sparse tensor has
+ * one single-cell block per cell, while a dense tensor has a single
+ * block with an empty address.
+ */
+struct SubspaceList {
+    using Subspace = std::pair<SparseTensorAddressRef, const double *>;
+    ValueType mappedType;
+    ValueType denseType;
+    std::vector<Subspace> subspaces;
+    SubspaceList(const ValueType &mappedType_in, const ValueType &denseType_in)
+        : mappedType(mappedType_in),
+          denseType(denseType_in),
+          subspaces()
+    {}
+};
+
+std::unique_ptr<SubspaceList>
+makeSubspaceList(const Tensor &tensor)
+{
+    if (auto mixed = dynamic_cast<const MixedTensor *>(&tensor)) {
+        auto list = std::make_unique<SubspaceList>(mixed->fast_mapped_type(), mixed->fast_dense_type());
+        list->subspaces.reserve(mixed->index().size());
+        for (const auto &entry : mixed->index()) {
+            list->subspaces.emplace_back(entry.first, mixed->subspace(entry.second).begin());
+        }
+        return list;
+    }
+    if (auto dense = dynamic_cast<const DenseTensorView *>(&tensor)) {
+        auto list = std::make_unique<SubspaceList>(ValueType::double_type(), dense->fast_type());
+        list->subspaces.emplace_back(SparseTensorAddressRef(), dense->cellsRef().begin());
+        return list;
+    }
+    if (auto sparse = dynamic_cast<const SparseTensor *>(&tensor)) {
+        auto list = std::make_unique<SubspaceList>(sparse->fast_type(), ValueType::double_type());
+        list->subspaces.reserve(sparse->cells().size());
+        for (const auto &cell : sparse->cells()) {
+            list->subspaces.emplace_back(cell.first, &cell.second);
+        }
+        return list;
+    }
+    return std::unique_ptr<SubspaceList>();
+}
+
+/**
+ * Calculate, for each dimension in 'target', the distance between
+ * neighbouring cells along that dimension in a dense subspace of
+ * 'type'. Dimensions not in 'type' get a stride of 0.
+ */
+std::vector<size_t>
+stridesFor(const ValueType &type, const ValueType &target)
+{
+    std::vector<size_t> strides(target.dimensions().size(), 0);
+    size_t stride = 1;
+    for (size_t i = type.dimensions().size(); i-- > 0; ) {
+        const auto &dimension = type.dimensions()[i];
+        size_t idx = target.dimension_index(dimension.name);
+        if (idx != ValueType::Dimension::npos) {
+            strides[idx] = stride;
+        }
+        stride *= dimension.size;
+    }
+    return strides;
+}
+
+/**
+ * Visit all cells of a dense subspace of the given type in storage
+ * order, passing the cell offsets obtained by applying two sets of
+ * strides to the cell index.
+ */
+template <typename Function>
+void
+forEachDenseCell(const ValueType &type,
+                 const std::vector<size_t> &aStrides,
+                 const std::vector<size_t> &bStrides,
+                 Function &&func)
+{
+    const auto &dimensions = type.dimensions();
+    std::vector<size_t> idx(dimensions.size(), 0);
+    size_t cells = 1;
+    for (const auto &dimension : dimensions) {
+        cells *= dimension.size;
+    }
+    size_t a = 0;
+    size_t b = 0;
+    for (size_t i = 0; i < cells; ++i) {
+        func(a, b);
+        for (size_t d = dimensions.size(); d-- > 0; ) {
+            ++idx[d];
+            a += aStrides[d];
+            b += bStrides[d];
+            if (idx[d] < dimensions[d].size) {
+                break;
+            }
+            a -= aStrides[d] * idx[d];
+            b -= bStrides[d] * idx[d];
+            idx[d] = 0;
+        }
+    }
+}
+
+/**
+ * Visit all cells of a dense subspace of the given type in storage
+ * order, passing the index along each dimension.
+ */
+template <typename Function>
+void
+forEachDenseAddress(const ValueType &type, Function &&func)
+{
+    const auto &dimensions = type.dimensions();
+    std::vector<size_t> idx(dimensions.size(), 0);
+    size_t cells = 1;
+    for (const auto &dimension : dimensions) {
+        cells *= dimension.size;
+    }
+    for (size_t i = 0; i < cells; ++i) {
+        func(idx, i);
+        for (size_t d = dimensions.size(); d-- > 0; ) {
+            if (++idx[d] < dimensions[d].size) {
+                break;
+            }
+            idx[d] = 0;
+        }
+    }
+}
+
+void
+decodeLabels(const ValueType &mappedType, SparseTensorAddressRef ref, std::vector<vespalib::string> &labels)
+{
+    labels.clear();
+    SparseTensorAddressDecoder decoder(ref);
+    for (size_t i = 0; i < mappedType.dimensions().size(); ++i) {
+        labels.emplace_back(decoder.decodeLabel());
+    }
+    assert(!decoder.valid());
+}
+
+using SubspaceIndex = hash_map<SparseTensorAddressRef, const double *, hash<SparseTensorAddressRef>,
+                               std::equal_to<SparseTensorAddressRef>, hashtable_base::and_modulator>;
+
+}
+
+MixedTensor::MixedTensor(eval::ValueType type_in, Index &&index_in, Cells &&cells_in, Stash &&stash_in)
+    : _type(std::move(type_in)),
+      _mappedType(mapped_type(_type)),
+      _denseType(dense_type(_type)),
+      _denseSize(1),
+      _index(std::move(index_in)),
+      _cells(std::move(cells_in)),
+      _stash(std::move(stash_in))
+{
+    for (const auto &dimension : _denseType.dimensions()) {
+        _denseSize *= dimension.size;
+    }
+    assert(_cells.size() == _index.size() * _denseSize);
+}
+
+MixedTensor::~MixedTensor() = default;
+
+bool
+MixedTensor::is_mixed(const eval::ValueType &type)
+{
+    bool mapped = false;
+    bool indexed = false;
+    for (const auto &dimension : type.dimensions()) {
+        mapped = (mapped || dimension.is_mapped());
+        indexed = (indexed || dimension.is_indexed());
+    }
+    return (mapped && indexed);
+}
+
+eval::ValueType
+MixedTensor::mapped_type(const eval::ValueType &type)
+{
+    std::vector<ValueType::Dimension> dimensions;
+    for (const auto &dimension : type.dimensions()) {
+        if (dimension.is_mapped()) {
+            dimensions.push_back(dimension);
+        }
+    }
+    return makeValueType(std::move(dimensions));
+}
+
+eval::ValueType
+MixedTensor::dense_type(const eval::ValueType &type)
+{
+    std::vector<ValueType::Dimension> dimensions;
+    for (const auto &dimension : type.dimensions()) {
+        if (dimension.is_indexed()) {
+            dimensions.push_back(dimension);
+        }
+    }
+    return makeValueType(std::move(dimensions));
+}
+
+Tensor::UP
+MixedTensor::join(join_fun_t function, const Tensor &lhs, const Tensor &rhs)
+{
+    auto lhsList = makeSubspaceList(lhs);
+    auto rhsList = makeSubspaceList(rhs);
+    if (!lhsList || !rhsList) {
+        return Tensor::UP();
+    }
+    ValueType resultType = ValueType::join(lhs.type(), rhs.type());
+    if (resultType.is_error()) {
+        return Tensor::UP();
+    }
+    MixedTensorBuilder builder(resultType);
+    // Cell offsets into the lhs and rhs subspaces for each result cell,
+    // shared by all pairs of subspaces being joined.
+    std::vector<size_t> lhsOffsets;
+    std::vector<size_t> rhsOffsets;
+    lhsOffsets.reserve(builder.dense_size());
+    rhsOffsets.reserve(builder.dense_size());
+    forEachDenseCell(builder.fast_dense_type(),
+                     stridesFor(lhsList->denseType, builder.fast_dense_type()),
+                     stridesFor(rhsList->denseType, builder.fast_dense_type()),
+                     [&](size_t a, size_t b) { lhsOffsets.push_back(a); rhsOffsets.push_back(b); });
+    size_t denseSize = builder.dense_size();
+    auto joinSubspaces = [&](SparseTensorAddressRef address, const double *lhsCells, const double *rhsCells) {
+        double *dst = builder.cells(builder.subspace(address).first);
+        for (size_t i = 0; i < denseSize; ++i) {
+            dst[i] = function(lhsCells[lhsOffsets[i]], rhsCells[rhsOffsets[i]]);
+        }
+    };
+    if (lhsList->mappedType == rhsList->mappedType) {
+        // Only subspaces with equal addresses match; look them up directly.
+        SubspaceIndex rhsIndex(rhsList->subspaces.size() * 2);
+        for (const auto &subspace : rhsList->subspaces) {
+            rhsIndex.insert(std::make_pair(subspace.first, subspace.second));
+        }
+        builder.reserve(std::min(lhsList->subspaces.size(), rhsList->subspaces.size()));
+        for (const auto &subspace : lhsList->subspaces) {
+            auto found = rhsIndex.find(subspace.first);
+            if (found != rhsIndex.end()) {
+                joinSubspaces(subspace.first, subspace.second, found->second);
+            }
+        }
+    } else {
+        sparse::TensorAddressCombiner addressCombiner(lhsList->mappedType, rhsList->mappedType);
+        for (const auto &lhsSubspace : lhsList->subspaces) {
+            for (const auto &rhsSubspace : rhsList->subspaces) {
+                if (addressCombiner.combine(lhsSubspace.first, rhsSubspace.first)) {
+                    joinSubspaces(addressCombiner.getAddressRef(), lhsSubspace.second, rhsSubspace.second);
+                }
+            }
+        }
+    }
+    return builder.build();
+}
+
+Tensor::UP
+MixedTensor::create(const eval::TensorSpec &spec)
+{
+    MixedTensorBuilder builder(ValueType::from_spec(spec.type()));
+    SparseTensorAddressBuilder address;
+    for (const auto &cell : spec.cells()) {
+        address.clear();
+        for (const auto &dimension : builder.fast_mapped_type().dimensions()) {
+            auto pos = cell.first.find(dimension.name);
+            assert(pos != cell.first.end());
+            address.add(pos->second.name);
+        }
+        size_t offset = 0;
+        for (const auto &dimension : builder.fast_dense_type().dimensions()) {
+            auto pos = cell.first.find(dimension.name);
+            assert(pos != cell.first.end());
+            assert(pos->second.index < dimension.size);
+            offset = (offset * dimension.size) + pos->second.index;
+        }
+        *builder.cells(builder.subspace(address.getAddressRef()).first + offset) = cell.second.value;
+    }
+    return builder.build();
+}
+
+const eval::ValueType &
+MixedTensor::type() const
+{
+    return _type;
+}
+
+double
+MixedTensor::as_double() const
+{
+    double result = 0.0;
+    for (double cell : _cells) {
+        result += cell;
+    }
+    return result;
+}
+
+Tensor::UP
+MixedTensor::apply(const CellFunction &func) const
+{
+    MixedTensorBuilder builder(_type);
+    builder.reserve(_index.size());
+    for (const auto &entry : _index) {
+        double *dst = builder.cells(builder.subspace(entry.first).first);
+        ConstArrayRef<double> src = subspace(entry.second);
+        for (size_t i = 0; i < _denseSize; ++i) {
+            dst[i] = func.apply(src[i]);
+        }
+    }
+    return builder.build();
+}
+
+Tensor::UP
+MixedTensor::join(join_fun_t function, const Tensor &arg) const
+{
+    return join(function, *this, arg);
+}
+
+Tensor::UP
+MixedTensor::reduce(join_fun_t op, const std::vector<vespalib::string> &dimensions) const
+{
+    ValueType resultType = _type.reduce(dimensions);
+    if (resultType.is_error()) {
+        return Tensor::UP();
+    }
+    std::vector<vespalib::string> removedMapped;
+    for (const auto &dimension : _mappedType.dimensions()) {
+        if (dimensions.empty() ||
+            (std::find(dimensions.begin(), dimensions.end(), dimension.name) != dimensions.end()))
+        {
+            removedMapped.push_back(dimension.name);
+        }
+    }
+    MixedTensorBuilder builder(resultType);
+    // Result cell offset for each cell in a subspace, and whether it is
+    // the first cell of the subspace contributing to that result cell.
+    std::vector<size_t> targetOffsets;
+    targetOffsets.reserve(_denseSize);
+    forEachDenseCell(_denseType,
+                     stridesFor(builder.fast_dense_type(), _denseType),
+                     std::vector<size_t>(_denseType.dimensions().size(), 0),
+                     [&](size_t target, size_t) { targetOffsets.push_back(target); });
+    std::vector<bool> first(_denseSize, false);
+    std::vector<bool> seen(builder.dense_size(), false);
+    for (size_t i = 0; i < _denseSize; ++i) {
+        first[i] = !seen[targetOffsets[i]];
+        seen[targetOffsets[i]] = true;
+    }
+    sparse::TensorAddressReducer addressReducer(_mappedType, removedMapped);
+    for (const auto &entry : _index) {
+        addressReducer.reduce(entry.first);
+        auto target = builder.subspace(addressReducer.getAddressRef());
+        double *dst = builder.cells(target.first);
+        ConstArrayRef<double> src = subspace(entry.second);
+        for (size_t i = 0; i < _denseSize; ++i) {
+            double &cell = dst[targetOffsets[i]];
+            cell = (target.second && first[i]) ? src[i] : op(cell, src[i]);
+        }
+    }
+    return builder.build();
+}
+
+std::unique_ptr<Tensor>
+MixedTensor::modify(join_fun_t, const CellValues &) const
+{
+    LOG_ABORT("should not be reached");
+}
+
+std::unique_ptr<Tensor>
+MixedTensor::add(const Tensor &) const
+{
+    LOG_ABORT("should not be reached");
+}
+
+bool
+MixedTensor::equals(const Tensor &arg) const
+{
+    return (toSpec() == arg.toSpec());
+}
+
+Tensor::UP
+MixedTensor::clone() const
+{
+    Index index(_index.size() * 2);
+    Stash stash(STASH_CHUNK_SIZE);
+    for (const auto &entry : _index) {
+        index.insert(std::make_pair(SparseTensorAddressRef(entry.first, stash), entry.second));
+    }
+    return std::make_unique<MixedTensor>(_type, std::move(index), Cells(_cells), std::move(stash));
+}
+
+TensorSpec
+MixedTensor::toSpec() const
+{
+    TensorSpec result(_type.to_spec());
+    TensorSpec::Address address;
+    std::vector<vespalib::string> labels;
+    const auto &denseDimensions = _denseType.dimensions();
+    for (const auto &entry : _index) {
+        decodeLabels(_mappedType, entry.first, labels);
+        ConstArrayRef<double> cells = subspace(entry.second);
+        forEachDenseAddress(_denseType, [&](const std::vector<size_t> &idx, size_t i) {
+            address.clear();
+            for (size_t d = 0; d < labels.size(); ++d) {
+                address.emplace(_mappedType.dimensions()[d].name, TensorSpec::Label(labels[d]));
+            }
+            for (size_t d = 0; d < denseDimensions.size(); ++d) {
+                address.emplace(denseDimensions[d].name, TensorSpec::Label(idx[d]));
+            }
+            result.add(address, cells[i]);
+        });
+    }
+    return result;
+}
+
+void
+MixedTensor::accept(TensorVisitor &visitor) const
+{
+    TensorAddressBuilder addrBuilder;
+    std::vector<vespalib::string> labels;
+    for (const auto &entry : _index) {
+        decodeLabels(_mappedType, entry.first, labels);
+        ConstArrayRef<double> cells = subspace(entry.second);
+        forEachDenseAddress(_denseType, [&](const std::vector<size_t> &idx, size_t i) {
+            addrBuilder.clear();
+            size_t mappedIdx = 0;
+            size_t denseIdx = 0;
+            for (const auto &dimension : _type.dimensions()) {
+                if (dimension.is_mapped()) {
+                    addrBuilder.add(dimension.name, labels[mappedIdx++]);
+                } else {
+                    addrBuilder.add(dimension.name, make_string("%zu", idx[denseIdx++]));
+                }
+            }
+            visitor.visit(addrBuilder.build(), cells[i]);
+        });
+    }
+}
+
+}
+
+VESPALIB_HASH_MAP_INSTANTIATE_H_E_M(vespalib::tensor::SparseTensorAddressRef, uint32_t, vespalib::hash<vespalib::tensor::SparseTensorAddressRef>,
+        std::equal_to<vespalib::tensor::SparseTensorAddressRef>, vespalib::hashtable_base::and_modulator);
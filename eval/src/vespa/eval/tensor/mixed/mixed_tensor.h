@@ -0,0 +1,79 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_ref.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/stash.h>
+#include <vector>
+
+namespace vespalib::tensor {
+
+/**
+ * A tensor with both mapped and indexed dimensions. For each
+ * combination of labels for the mapped dimensions (serialized the
+ * same way as SparseTensor addresses) a dense subspace holding all
+ * cells for the indexed dimensions is stored. The subspaces are
+ * stored back to back in a single cell array, which lets operations
+ * work on contiguous blocks instead of on individual cells with
+ * fully specified addresses.
+ */
+class MixedTensor : public Tensor
+{
+public:
+    using Index = hash_map<SparseTensorAddressRef, uint32_t, hash<SparseTensorAddressRef>,
+                           std::equal_to<SparseTensorAddressRef>, hashtable_base::and_modulator>;
+    using Cells = std::vector<double>;
+
+    static constexpr size_t STASH_CHUNK_SIZE = 16384u;
+
+private:
+    eval::ValueType _type;
+    eval::ValueType _mappedType;
+    eval::ValueType _denseType;
+    size_t          _denseSize;
+    Index           _index;
+    Cells           _cells;
+    Stash           _stash;
+
+public:
+    MixedTensor(eval::ValueType type_in, Index &&index_in, Cells &&cells_in, Stash &&stash_in);
+    ~MixedTensor() override;
+
+    static bool is_mixed(const eval::ValueType &type);
+    static eval::ValueType mapped_type(const eval::ValueType &type);
+    static eval::ValueType dense_type(const eval::ValueType &type);
+
+    const eval::ValueType &fast_type() const { return _type; }
+    const eval::ValueType &fast_mapped_type() const { return _mappedType; }
+    const eval::ValueType &fast_dense_type() const { return _denseType; }
+    size_t dense_size() const { return _denseSize; }
+    const Index &index() const { return _index; }
+    ConstArrayRef<double> subspace(uint32_t idx) const {
+        return ConstArrayRef<double>(&_cells[idx * _denseSize], _denseSize);
+    }
+
+    /**
+     * Join two tensors where at least one is mixed. The other one may
+     * be a mixed, sparse or dense tensor. Returns an empty pointer if
+     * one of the tensors is of an unsupported implementation.
+     */
+    static Tensor::UP join(join_fun_t function, const Tensor &lhs, const Tensor &rhs);
+    static Tensor::UP create(const eval::TensorSpec &spec);
+
+    const eval::ValueType &type() const override;
+    double as_double() const override;
+    Tensor::UP apply(const CellFunction &func) const override;
+    Tensor::UP join(join_fun_t function, const Tensor &arg) const override;
+    Tensor::UP reduce(join_fun_t op, const std::vector<vespalib::string> &dimensions) const override;
+    std::unique_ptr<Tensor> modify(join_fun_t op, const CellValues &cellValues) const override;
+    std::unique_ptr<Tensor> add(const Tensor &arg) const override;
+    bool equals(const Tensor &arg) const override;
+    Tensor::UP clone() const override;
+    eval::TensorSpec toSpec() const override;
+    void accept(TensorVisitor &visitor) const override;
+};
+
+}
@@ -0,0 +1,67 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_tensor_builder.h"
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/sparse/direct_sparse_tensor_builder.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace vespalib::tensor {
+
+MixedTensorBuilder::MixedTensorBuilder(const eval::ValueType &type)
+    : _type(type),
+      _mappedType(MixedTensor::mapped_type(type)),
+      _denseType(MixedTensor::dense_type(type)),
+      _denseSize(1),
+      _index(),
+      _cells(),
+      _stash(MixedTensor::STASH_CHUNK_SIZE)
+{
+    for (const auto &dimension : _denseType.dimensions()) {
+        _denseSize *= dimension.size;
+    }
+}
+
+MixedTensorBuilder::~MixedTensorBuilder() = default;
+
+void
+MixedTensorBuilder::reserve(size_t subspaces)
+{
+    _index.resize(subspaces * 2);
+    _cells.reserve(subspaces * _denseSize);
+}
+
+std::pair<size_t, bool>
+MixedTensorBuilder::subspace(SparseTensorAddressRef address)
+{
+    uint32_t next = _index.size();
+    auto res = _index.insert(std::make_pair(address, next));
+    if (res.second) {
+        // Replace key with own copy
+        res.first->first = SparseTensorAddressRef(address, _stash);
+        _cells.resize(_cells.size() + _denseSize, 0.0);
+    }
+    return std::make_pair(size_t(res.first->second) * _denseSize, res.second);
+}
+
+Tensor::UP
+MixedTensorBuilder::build()
+{
+    if (_mappedType.dimensions().empty()) {
+        // Only the subspace with the empty address can exist
+        if (_cells.empty()) {
+            _cells.resize(_denseSize, 0.0);
+        }
+        return std::make_unique<DenseTensor>(std::move(_type), std::move(_cells));
+    }
+    if (_denseType.dimensions().empty()) {
+        DirectTensorBuilder<SparseTensor> builder(_type);
+        builder.reserve(_index.size());
+        for (const auto &entry : _index) {
+            builder.insertCell(entry.first, _cells[entry.second]);
+        }
+        return builder.build();
+    }
+    return std::make_unique<MixedTensor>(std::move(_type), std::move(_index), std::move(_cells), std::move(_stash));
+}
+
+}
@@ -0,0 +1,46 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "mixed_tensor.h"
+
+namespace vespalib::tensor {
+
+/**
+ * Utility class used to build tensors subspace by subspace. The
+ * built tensor is a MixedTensor if the type has both mapped and
+ * indexed dimensions, otherwise a SparseTensor or DenseTensor.
+ */
+class MixedTensorBuilder
+{
+private:
+    eval::ValueType    _type;
+    eval::ValueType    _mappedType;
+    eval::ValueType    _denseType;
+    size_t             _denseSize;
+    MixedTensor::Index _index;
+    MixedTensor::Cells _cells;
+    Stash              _stash;
+
+public:
+    explicit MixedTensorBuilder(const eval::ValueType &type);
+    ~MixedTensorBuilder();
+
+    const eval::ValueType &fast_mapped_type() const { return _mappedType; }
+    const eval::ValueType &fast_dense_type() const { return _denseType; }
+    size_t dense_size() const { return _denseSize; }
+    void reserve(size_t subspaces);
+
+    /**
+     * Look up the subspace for the given mapped address, adding a
+     * zero-filled subspace if it does not exist. Returns the offset
+     * of the first cell of the subspace and whether it was added.
+     * The offset stays valid while building, pointers do not.
+     */
+    std::pair<size_t, bool> subspace(SparseTensorAddressRef address);
+    double *cells(size_t offset) { return &_cells[offset]; }
+
+    Tensor::UP build();
+};
+
+}
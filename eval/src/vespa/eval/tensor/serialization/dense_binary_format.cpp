@@ -54,11 +54,12 @@ DenseBinaryFormat::deserialize(nbostream &stream)
         dimensions.emplace_back(dimensionName, dimensionSize);
         cellsSize *= dimensionSize;
     }
-    cells.reserve(cellsSize);
-    double cellValue = 0.0;
-    for (size_t i = 0; i < cellsSize; ++i) {
-        stream >> cellValue;
-        cells.emplace_back(cellValue);
+    // Cells are stored back to back, read them in one go and convert
+    // them to host byte order in place.
+    cells.resize(cellsSize);
+    stream.read(cells.data(), cellsSize * sizeof(double));
+    for (double &cell : cells) {
+        cell = nbo::n2h(cell);
     }
     return std::make_unique<DenseTensor>(makeValueType(std::move(dimensions)),
                                          std::move(cells));
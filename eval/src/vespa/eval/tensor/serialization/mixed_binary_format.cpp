@@ -0,0 +1,93 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mixed_binary_format.h"
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_builder.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_address_decoder.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
+
+using vespalib::nbostream;
+using vespalib::eval::ValueType;
+
+namespace vespalib {
+namespace tensor {
+
+namespace {
+
+using Block = std::pair<SparseTensorAddressRef, uint32_t>;
+
+bool blockLess(const Block &lhs, const Block &rhs) { return lhs.first < rhs.first; }
+
+}
+
+void
+MixedBinaryFormat::serialize(nbostream &stream, const MixedTensor &tensor)
+{
+    const auto &mappedDimensions = tensor.fast_mapped_type().dimensions();
+    const auto &denseDimensions = tensor.fast_dense_type().dimensions();
+    stream.putInt1_4Bytes(mappedDimensions.size());
+    for (const auto &dimension : mappedDimensions) {
+        stream.writeSmallString(dimension.name);
+    }
+    stream.putInt1_4Bytes(denseDimensions.size());
+    for (const auto &dimension : denseDimensions) {
+        stream.writeSmallString(dimension.name);
+        stream.putInt1_4Bytes(dimension.size);
+    }
+    // Write blocks ordered by labels, as SimpleTensor does.
+    std::vector<Block> blocks(tensor.index().begin(), tensor.index().end());
+    std::sort(blocks.begin(), blocks.end(), blockLess);
+    stream.putInt1_4Bytes(blocks.size());
+    for (const auto &block : blocks) {
+        SparseTensorAddressDecoder decoder(block.first);
+        for (size_t i = 0; i < mappedDimensions.size(); ++i) {
+            stream.writeSmallString(decoder.decodeLabel());
+        }
+        for (double value : tensor.subspace(block.second)) {
+            stream << value;
+        }
+    }
+}
+
+
+std::unique_ptr<Tensor>
+MixedBinaryFormat::deserialize(nbostream &stream)
+{
+    vespalib::string name;
+    std::vector<ValueType::Dimension> dimensions;
+    size_t mappedDimensionsSize = stream.getInt1_4Bytes();
+    for (size_t i = 0; i < mappedDimensionsSize; ++i) {
+        stream.readSmallString(name);
+        dimensions.emplace_back(name);
+    }
+    size_t denseDimensionsSize = stream.getInt1_4Bytes();
+    for (size_t i = 0; i < denseDimensionsSize; ++i) {
+        stream.readSmallString(name);
+        dimensions.emplace_back(name, stream.getInt1_4Bytes());
+    }
+    MixedTensorBuilder builder(dimensions.empty() ?
+                               ValueType::double_type() :
+                               ValueType::tensor_type(std::move(dimensions)));
+    size_t numBlocks = (mappedDimensionsSize > 0) ? stream.getInt1_4Bytes() : 1;
+    builder.reserve(numBlocks);
+    SparseTensorAddressBuilder address;
+    vespalib::string label;
+    for (size_t i = 0; i < numBlocks; ++i) {
+        address.clear();
+        for (size_t j = 0; j < mappedDimensionsSize; ++j) {
+            stream.readSmallString(label);
+            address.add(label);
+        }
+        double *cells = builder.cells(builder.subspace(address.getAddressRef()).first);
+        for (size_t j = 0; j < builder.dense_size(); ++j) {
+            stream >> cells[j];
+        }
+    }
+    return builder.build();
+}
+
+
+} // namespace vespalib::tensor
+} // namespace vespalib
@@ -0,0 +1,29 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <memory>
+
+namespace vespalib {
+
+class nbostream;
+
+namespace tensor {
+
+class Tensor;
+class MixedTensor;
+
+/**
+ * Class for serializing a mixed tensor. The format is the same as the
+ * one used by SimpleTensor for types with both mapped and indexed
+ * dimensions, but the dense subspaces are copied as whole blocks.
+ */
+class MixedBinaryFormat
+{
+public:
+    static void serialize(nbostream &stream, const MixedTensor &tensor);
+    static std::unique_ptr<Tensor> deserialize(nbostream &stream);
+};
+
+} // namespace vespalib::tensor
+} // namespace vespalib
@@ -5,7 +5,10 @@
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/tensor_builder.h>
 #include <vespa/eval/tensor/tensor_visitor.h>
+#include <vespa/eval/tensor/sparse/direct_sparse_tensor_builder.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <cassert>
 
@@ -36,6 +39,16 @@ writeTensorAddress(nbostream &output,
     assert(elemItr == elemItrEnd);
 }
 
+// Label referencing the bytes of the stream, valid while the stream is.
+vespalib::stringref
+readLabel(nbostream &stream)
+{
+    size_t labelSize = stream.getInt1_4Bytes();
+    const char *label = stream.peek();
+    stream.adjustReadPos(labelSize);
+    return vespalib::stringref(label, labelSize);
+}
+
 }
 
 class SparseBinaryFormatSerializer : public TensorVisitor
@@ -121,5 +134,45 @@ SparseBinaryFormat::deserialize(nbostream &stream, TensorBuilder &builder)
 }
 
 
+std::unique_ptr<Tensor>
+SparseBinaryFormat::deserialize(nbostream &stream)
+{
+    vespalib::string str;
+    size_t dimensionsSize = stream.getInt1_4Bytes();
+    std::vector<eval::ValueType::Dimension> dimensions;
+    while (dimensions.size() < dimensionsSize) {
+        stream.readSmallString(str);
+        dimensions.emplace_back(str);
+    }
+    // Addresses have labels in sorted dimension order, while the
+    // serialized labels are in the order the dimensions were written.
+    std::vector<size_t> order(dimensionsSize);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&dimensions](size_t a, size_t b) { return (dimensions[a].name < dimensions[b].name); });
+    eval::ValueType type = (dimensions.empty() ?
+                            eval::ValueType::double_type() :
+                            eval::ValueType::tensor_type(std::move(dimensions)));
+    DirectTensorBuilder<SparseTensor> builder(type);
+    SparseTensorAddressBuilder address;
+    std::vector<vespalib::stringref> labels(dimensionsSize);
+    size_t cellsSize = stream.getInt1_4Bytes();
+    builder.reserve(std::min(cellsSize, stream.size() / sizeof(double)));
+    double cellValue = 0.0;
+    for (size_t cellIdx = 0; cellIdx < cellsSize; ++cellIdx) {
+        for (auto &label : labels) {
+            label = readLabel(stream);
+        }
+        address.clear();
+        for (size_t dimension : order) {
+            address.add(labels[dimension]);
+        }
+        stream >> cellValue;
+        builder.insertCell(address, cellValue, [](double, double rhs) { return rhs; });
+    }
+    return builder.build();
+}
+
+
 } // namespace vespalib::tensor
 } // namespace vespalib
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <memory>
+
 namespace vespalib {
 
 class nbostream;
@@ -19,6 +21,7 @@ class SparseBinaryFormat
 public:
     static void serialize(nbostream &stream, const Tensor &tensor);
     static void deserialize(nbostream &stream, TensorBuilder &builder);
+    static std::unique_ptr<Tensor> deserialize(nbostream &stream);
 };
 
 } // namespace vespalib::tensor
@@ -3,10 +3,12 @@
 #include "typed_binary_format.h"
 #include "sparse_binary_format.h"
 #include "dense_binary_format.h"
+#include "mixed_binary_format.h"
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/eval/tensor/default_tensor.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
 #include <vespa/eval/eval/simple_tensor.h>
 #include <vespa/eval/tensor/wrapped_simple_tensor.h>
 
@@ -25,6 +27,9 @@ TypedBinaryFormat::serialize(nbostream &stream, const Tensor &tensor)
     if (auto denseTensor = dynamic_cast<const DenseTensorView *>(&tensor)) {
         stream.putInt1_4Bytes(DENSE_BINARY_FORMAT_TYPE);
         DenseBinaryFormat::serialize(stream, *denseTensor);
+    } else if (auto mixedTensor = dynamic_cast<const MixedTensor *>(&tensor)) {
+        stream.putInt1_4Bytes(MIXED_BINARY_FORMAT_TYPE);
+        MixedBinaryFormat::serialize(stream, *mixedTensor);
     } else if (auto wrapped = dynamic_cast<const WrappedSimpleTensor *>(&tensor)) {
         eval::SimpleTensor::encode(wrapped->get(), stream);
     } else {
@@ -37,19 +42,15 @@ TypedBinaryFormat::serialize(nbostream &stream, const Tensor &tensor)
 std::unique_ptr<Tensor>
 TypedBinaryFormat::deserialize(nbostream &stream)
 {
-    auto read_pos = stream.rp();
     auto formatId = stream.getInt1_4Bytes();
     if (formatId == SPARSE_BINARY_FORMAT_TYPE) {
-        DefaultTensor::builder builder;
-        SparseBinaryFormat::deserialize(stream, builder);
-        return builder.build();
+        return SparseBinaryFormat::deserialize(stream);
     }
     if (formatId == DENSE_BINARY_FORMAT_TYPE) {
         return DenseBinaryFormat::deserialize(stream);
     }
     if (formatId == MIXED_BINARY_FORMAT_TYPE) {
-        stream.adjustReadPos(read_pos - stream.rp());
-        return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::decode(stream));
+        return MixedBinaryFormat::deserialize(stream);
     }
     LOG_ABORT("should not be reached");
 }
@@ -25,10 +25,13 @@ private:
     vespalib::Array<char> _address;
 
 protected:
+    // The label need not be NUL terminated (it may refer into a
+    // serialized tensor), so the terminator is written explicitly.
     void append(vespalib::stringref str) {
-        for (size_t i(0); i < str.size() + 1; i++) {
+        for (size_t i(0); i < str.size(); i++) {
             _address.push_back_fast(str[i]);
         }
+        _address.push_back_fast('\0');
     }
     void ensure_room(size_t additional) {
         if (_address.capacity() < (_address.size() + additional)) {
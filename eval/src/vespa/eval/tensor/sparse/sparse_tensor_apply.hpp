@@ -4,6 +4,7 @@
 
 #include "sparse_tensor_apply.h"
 #include "sparse_tensor_address_combiner.h"
+#include "sparse_tensor_sorted_cells.h"
 #include <vespa/eval/tensor/direct_tensor_builder.h>
 #include "direct_sparse_tensor_builder.h"
 
@@ -14,20 +15,62 @@ std::unique_ptr<Tensor>
 apply(const SparseTensor &lhs, const SparseTensor &rhs, Function &&func)
 {
     DirectTensorBuilder<SparseTensor> builder(lhs.combineDimensionsWith(rhs));
-    TensorAddressCombiner addressCombiner(lhs.fast_type(), rhs.fast_type());
-    size_t estimatedCells = (lhs.cells().size() * rhs.cells().size());
-    if (addressCombiner.numOverlappingDimensions() != 0) {
-        estimatedCells = std::min(lhs.cells().size(), rhs.cells().size());
+    if (lhs.fast_type() == rhs.fast_type()) {
+        // All dimensions are common; look up each cell directly
+        builder.reserve(std::min(lhs.cells().size(), rhs.cells().size()));
+        if (lhs.cells().size() <= rhs.cells().size()) {
+            for (const auto &lhsCell : lhs.cells()) {
+                auto rhsItr = rhs.cells().find(lhsCell.first);
+                if (rhsItr != rhs.cells().end()) {
+                    builder.insertCell(lhsCell.first, func(lhsCell.second, rhsItr->second));
+                }
+            }
+        } else {
+            for (const auto &rhsCell : rhs.cells()) {
+                auto lhsItr = lhs.cells().find(rhsCell.first);
+                if (lhsItr != lhs.cells().end()) {
+                    builder.insertCell(rhsCell.first, func(lhsItr->second, rhsCell.second));
+                }
+            }
+        }
+        return builder.build();
     }
-    builder.reserve(estimatedCells*2);
-    for (const auto &lhsCell : lhs.cells()) {
-        for (const auto &rhsCell : rhs.cells()) {
-            bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
-            if (combineSuccess) {
+    TensorAddressCombiner addressCombiner(lhs.fast_type(), rhs.fast_type());
+    if (addressCombiner.numOverlappingDimensions() == 0) {
+        builder.reserve(lhs.cells().size() * rhs.cells().size());
+        for (const auto &lhsCell : lhs.cells()) {
+            for (const auto &rhsCell : rhs.cells()) {
+                addressCombiner.combine(lhsCell.first, rhsCell.first);
                 builder.insertCell(addressCombiner.getAddressRef(),
                                    func(lhsCell.second, rhsCell.second));
             }
         }
+        return builder.build();
+    }
+    // Merge-join on the labels of the common dimensions
+    builder.reserve(std::min(lhs.cells().size(), rhs.cells().size()));
+    SortedCells lhsCells(lhs, rhs.fast_type());
+    SortedCells rhsCells(rhs, lhs.fast_type());
+    auto lhsItr = lhsCells.begin();
+    auto rhsItr = rhsCells.begin();
+    while ((lhsItr != lhsCells.end()) && (rhsItr != rhsCells.end())) {
+        if (lhsItr->key < rhsItr->key) {
+            ++lhsItr;
+        } else if (rhsItr->key < lhsItr->key) {
+            ++rhsItr;
+        } else {
+            auto lhsEnd = lhsCells.groupEnd(lhsItr);
+            auto rhsEnd = rhsCells.groupEnd(rhsItr);
+            for (auto lhsCell = lhsItr; lhsCell != lhsEnd; ++lhsCell) {
+                for (auto rhsCell = rhsItr; rhsCell != rhsEnd; ++rhsCell) {
+                    addressCombiner.combine(lhsCell->address, rhsCell->address);
+                    builder.insertCell(addressCombiner.getAddressRef(),
+                                       func(lhsCell->value, rhsCell->value));
+                }
+            }
+            lhsItr = lhsEnd;
+            rhsItr = rhsEnd;
+        }
     }
     return builder.build();
 }
@@ -0,0 +1,32 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_tensor_sorted_cells.h"
+#include "sparse_tensor.h"
+#include "sparse_tensor_address_reducer.h"
+#include <vespa/eval/eval/value_type.h>
+#include <algorithm>
+
+namespace vespalib::tensor::sparse {
+
+SortedCells::SortedCells(const SparseTensor &tensor, const eval::ValueType &other)
+    : _stash(),
+      _cells()
+{
+    std::vector<vespalib::string> removeDimensions;
+    for (const auto &dim : tensor.fast_type().dimensions()) {
+        if (other.dimension_index(dim.name) == eval::ValueType::Dimension::npos) {
+            removeDimensions.push_back(dim.name);
+        }
+    }
+    TensorAddressReducer keyBuilder(tensor.fast_type(), removeDimensions);
+    _cells.reserve(tensor.cells().size());
+    for (const auto &cell : tensor.cells()) {
+        keyBuilder.reduce(cell.first);
+        _cells.emplace_back(SparseTensorAddressRef(keyBuilder.getAddressRef(), _stash), cell.first, cell.second);
+    }
+    std::sort(_cells.begin(), _cells.end());
+}
+
+SortedCells::~SortedCells() = default;
+
+}
@@ -0,0 +1,57 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "sparse_tensor_address_ref.h"
+#include <vespa/vespalib/util/stash.h>
+#include <vector>
+
+namespace vespalib::eval { class ValueType; }
+namespace vespalib::tensor { class SparseTensor; }
+
+namespace vespalib::tensor::sparse {
+
+/**
+ * The cells of a sparse tensor in a flat array, sorted by the labels
+ * of the dimensions it has in common with another tensor type. Two
+ * such arrays can be merge-joined on their common dimensions instead
+ * of comparing all combinations of cells.
+ */
+class SortedCells
+{
+public:
+    struct Cell {
+        SparseTensorAddressRef key;
+        SparseTensorAddressRef address;
+        double value;
+        Cell(SparseTensorAddressRef key_in, SparseTensorAddressRef address_in, double value_in)
+            : key(key_in), address(address_in), value(value_in)
+        {}
+        bool operator<(const Cell &rhs) const { return (key < rhs.key); }
+    };
+    using const_iterator = std::vector<Cell>::const_iterator;
+
+private:
+    Stash             _stash;
+    std::vector<Cell> _cells;
+
+public:
+    SortedCells(const SparseTensor &tensor, const eval::ValueType &other);
+    ~SortedCells();
+    const_iterator begin() const { return _cells.begin(); }
+    const_iterator end() const { return _cells.end(); }
+
+    /**
+     * Returns the end of the group of cells starting at 'first' that
+     * have the same key.
+     */
+    const_iterator groupEnd(const_iterator first) const {
+        const_iterator pos = first;
+        while ((pos != _cells.end()) && (pos->key == first->key)) {
+            ++pos;
+        }
+        return pos;
+    }
+};
+
+}
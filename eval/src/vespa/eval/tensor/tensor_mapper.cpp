@@ -9,6 +9,7 @@
 #include <vespa/eval/tensor/sparse/direct_sparse_tensor_builder.h>
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/eval/tensor/dense/dense_tensor_address_mapper.h>
+#include <vespa/eval/tensor/mixed/mixed_tensor.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <limits>
 
@@ -270,31 +271,30 @@ DenseTensorMapper::map(const Tensor &tensor, const ValueType &type)
 
 //-----------------------------------------------------------------------------
 
-class WrappedTensorMapper : public TensorVisitor
+/**
+ * Maps a tensor to the cells of a tensor spec of the given type. Used
+ * for types with both mapped and indexed dimensions.
+ */
+class TensorSpecMapper : public TensorVisitor
 {
     using Label = TensorSpec::Label;
 
     ValueType  _type;
     TensorSpec _spec;
 
-    WrappedTensorMapper(const ValueType &type)
+    TensorSpecMapper(const ValueType &type)
         : _type(type), _spec(type.to_spec()) {}
-    ~WrappedTensorMapper() {}
+    ~TensorSpecMapper() {}
 
     void visit(const TensorAddress &address, double value) override;
 
-    std::unique_ptr<Tensor> build() {
-        auto tensor = eval::SimpleTensor::create(_spec);
-        return std::make_unique<WrappedSimpleTensor>(std::move(tensor));
-    }
-
 public:
-    static std::unique_ptr<Tensor>
+    static TensorSpec
     map(const Tensor &tensor, const ValueType &type);
 };
 
 void
-WrappedTensorMapper::visit(const TensorAddress &address, double value)
+TensorSpecMapper::visit(const TensorAddress &address, double value)
 {
     TensorSpec::Address addr;
     TensorAddressElementIterator<TensorAddress> addressIterator(address);
@@ -321,14 +321,14 @@ WrappedTensorMapper::visit(const TensorAddress &address, double value)
     _spec.add(addr, value);
 }
 
-std::unique_ptr<Tensor>
-WrappedTensorMapper::map(const Tensor &tensor, const ValueType &type)
+TensorSpec
+TensorSpecMapper::map(const Tensor &tensor, const ValueType &type)
 {
-    WrappedTensorMapper mapper(type.is_abstract() ?
-                               TensorTypeMapper::map(tensor, type) :
-                               type);
+    TensorSpecMapper mapper(type.is_abstract() ?
+                            TensorTypeMapper::map(tensor, type) :
+                            type);
     tensor.accept(mapper);
-    return mapper.build();
+    return std::move(mapper._spec);
 }
 
 //-----------------------------------------------------------------------------
@@ -359,11 +359,18 @@ TensorMapper::mapToDense(const Tensor &tensor, const ValueType &type)
     return DenseTensorMapper::map(tensor, type);
 }
 
+std::unique_ptr<Tensor>
+TensorMapper::mapToMixed(const Tensor &tensor, const ValueType &type)
+{
+    assert(!type.dimensions().empty() && !type.is_sparse() && !type.is_dense());
+    return MixedTensor::create(TensorSpecMapper::map(tensor, type));
+}
+
 std::unique_ptr<Tensor>
 TensorMapper::mapToWrapped(const Tensor &tensor, const ValueType &type)
 {
     assert(!type.dimensions().empty());
-    return WrappedTensorMapper::map(tensor, type);
+    return std::make_unique<WrappedSimpleTensor>(eval::SimpleTensor::create(TensorSpecMapper::map(tensor, type)));
 }
 
 std::unique_ptr<Tensor>
@@ -374,7 +381,7 @@ TensorMapper::map(const Tensor &tensor) const
     } else if (_type.is_dense()) {
         return mapToDense(tensor, _type);
     } else {
-        return mapToWrapped(tensor, _type);
+        return mapToMixed(tensor, _type);
     }
 }
 
@@ -388,6 +388,15 @@ public:
      */
     virtual uint32_t getCommittedDocIdLimit() const = 0;
 
+    /**
+     * Returns a value that changes each time changes to the attribute
+     * are committed. Results calculated from the attribute contents
+     * can be reused as long as this value stays the same.
+     *
+     * @return commit generation of the attribute.
+     */
+    virtual uint64_t getCommitGeneration() const = 0;
+
     /*
      * Returns whether the current attribute vector is an imported attribute
      * vector.
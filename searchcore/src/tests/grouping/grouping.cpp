@@ -5,6 +5,7 @@
 #include <vespa/searchlib/aggregation/sumaggregationresult.h>
 #include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/aggregationrefnode.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchcore/grouping/groupingmanager.h>
@@ -245,6 +246,28 @@ TEST_F("testGroupingManager", DoomFixture()) {
     ASSERT_TRUE(!manager.empty());
 }
 
+TEST_F("require that only groupings in relevance order need sorted hits", DoomFixture()) {
+    Grouping resorting;
+    resorting.addLevel(std::move(GroupingLevel().setExpression(MU<AttributeNode>("attr0"))
+                                         .addAggregationResult(MU<SumAggregationResult>())
+                                         .addOrderBy(MU<AggregationRefNode>(0), false)));
+    Grouping limited;
+    limited.setTopN(5).addLevel(createGL(MU<AttributeNode>("attr1"), MU<AttributeNode>("attr2")));
+    Grouping ordered;
+    ordered.addLevel(createGL(MU<AttributeNode>("attr1"), MU<AttributeNode>("attr2")));
+
+    GroupingContext context(f1.clock, f1.timeOfDoom);
+    GroupingManager manager(context);
+    EXPECT_EQUAL(0u, manager.getRelevanceOrderHitCount(100));
+    context.addGrouping(GroupingContext::GroupingPtr(new Grouping(resorting)));
+    EXPECT_EQUAL(0u, manager.getRelevanceOrderHitCount(100));
+    context.addGrouping(GroupingContext::GroupingPtr(new Grouping(limited)));
+    EXPECT_EQUAL(5u, manager.getRelevanceOrderHitCount(100));
+    EXPECT_EQUAL(3u, manager.getRelevanceOrderHitCount(3));
+    context.addGrouping(GroupingContext::GroupingPtr(new Grouping(ordered)));
+    EXPECT_EQUAL(100u, manager.getRelevanceOrderHitCount(100));
+}
+
 TEST_F("testGroupingSession", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
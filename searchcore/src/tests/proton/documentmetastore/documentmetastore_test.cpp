@@ -1029,6 +1029,21 @@ TEST("requireThatBucketStateCanBeUpdated")
 }
 
 
+TEST("require that bucket state changes are reflected in the commit generation")
+{
+    UserDocFixture f;
+    f.dms.constructFreeList();
+    f.addGlobalIds();
+    uint64_t generation = f.dms.getCommitGeneration();
+    f.dms.setBucketState(f.bid1, true);
+    EXPECT_NOT_EQUAL(generation, f.dms.getCommitGeneration());
+    generation = f.dms.getCommitGeneration();
+    EXPECT_EQUAL(generation, f.dms.getCommitGeneration());
+    f.dms.setBucketState(f.bid1, false);
+    EXPECT_NOT_EQUAL(generation, f.dms.getCommitGeneration());
+}
+
+
 TEST("requireThatRemovedLidsAreClearedAsActive")
 {
     UserDocFixture f;
@@ -1832,7 +1847,9 @@ TEST("requireThatMoveWorks")
     EXPECT_FALSE(dms.getGidEvenIfMoved(1u, gid));
     EXPECT_TRUE(dms.getGid(2u, gid));
     EXPECT_EQUAL(1u, dms.getNumUsedLids());
+    EXPECT_TRUE(dms.isLidSpaceInFeedOrder());
     dms.move(2u, 1u);
+    EXPECT_FALSE(dms.isLidSpaceInFeedOrder());
     EXPECT_TRUE(dms.getGid(1u, gid));
     EXPECT_FALSE(dms.getGid(2u, gid));
     EXPECT_TRUE(dms.getGidEvenIfMoved(2u, gid));
@@ -1845,6 +1862,58 @@ TEST("requireThatMoveWorks")
     EXPECT_EQUAL(1u, lid);
 }
 
+TEST("require that lid space is not in feed order after lid reuse")
+{
+    DocumentMetaStore dms(createBucketDB());
+    EXPECT_TRUE(dms.isLidSpaceInFeedOrder());
+    putGid(dms, gid1, 1, time1);
+    putGid(dms, gid2, 2, time2);
+    putGid(dms, gid3, 3, time3);
+    EXPECT_TRUE(dms.isLidSpaceInFeedOrder());
+    EXPECT_TRUE(dms.remove(3));
+    putGid(dms, gid3, 4, time4);
+    EXPECT_TRUE(dms.isLidSpaceInFeedOrder());
+    EXPECT_TRUE(dms.remove(1));
+    putGid(dms, gid5, 1, time5);
+    EXPECT_FALSE(dms.isLidSpaceInFeedOrder());
+}
+
+TEST("require that lid space is not in feed order after appending an older document")
+{
+    DocumentMetaStore dms(createBucketDB());
+    putGid(dms, gid1, 1, time1);
+    putGid(dms, gid2, 2, time3);
+    putGid(dms, gid3, 3, time3);
+    EXPECT_TRUE(dms.isLidSpaceInFeedOrder());
+    putGid(dms, gid4, 4, time2);
+    EXPECT_FALSE(dms.isLidSpaceInFeedOrder());
+}
+
+bool
+isLidSpaceInFeedOrderAfterLoad(DocumentMetaStore &dms)
+{
+    TuneFileAttributes tuneFileAttributes;
+    DummyFileHeaderContext fileHeaderContext;
+    AttributeFileSaveTarget saveTarget(tuneFileAttributes, fileHeaderContext);
+    EXPECT_TRUE(dms.save(saveTarget, "documentmetastore3"));
+    DocumentMetaStore loaded(createBucketDB(), "documentmetastore3");
+    EXPECT_TRUE(loaded.load());
+    return loaded.isLidSpaceInFeedOrder();
+}
+
+TEST("require that lid space feed order is restored on load")
+{
+    DocumentMetaStore dms(createBucketDB());
+    putGid(dms, gid1, 1, time1);
+    putGid(dms, gid2, 2, time2);
+    putGid(dms, gid3, 4, time3);
+    EXPECT_TRUE(isLidSpaceInFeedOrderAfterLoad(dms));
+    EXPECT_TRUE(dms.remove(1));
+    putGid(dms, gid4, 1, time4);
+    EXPECT_FALSE(dms.isLidSpaceInFeedOrder());
+    EXPECT_FALSE(isLidSpaceInFeedOrderAfterLoad(dms));
+}
+
 bool
 assertLidSpace(uint32_t numDocs,
                uint32_t committedDocIdLimit,
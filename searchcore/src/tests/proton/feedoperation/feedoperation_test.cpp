@@ -296,14 +296,21 @@ TEST_F("require that we can serialize and deserialize put operations", Fixture)
         op.setDbDocumentId({1, 2});
         op.setPrevDbDocumentId({3, 4});
         EXPECT_EQUAL(0u, op.getSerializedDocSize());
+        EXPECT_TRUE(!op.getSerializedDocument());
         op.serialize(stream);
         EXPECT_EQUAL(expSerializedDocSize, op.getSerializedDocSize());
+        ASSERT_TRUE(op.getSerializedDocument());
+        EXPECT_EQUAL(expSerializedDocSize, op.getSerializedDocument()->size());
+        vespalib::nbostream serializedDoc(*op.getSerializedDocument());
+        EXPECT_EQUAL(*doc, Document(*f._repo, serializedDoc));
     }
     {
         PutOperation op;
         op.deserialize(stream, *f._repo);
         EXPECT_EQUAL(*doc, *op.getDocument());
         TEST_DO(assertDocumentOperation(op, bucket, expSerializedDocSize));
+        ASSERT_TRUE(op.getSerializedDocument());
+        EXPECT_EQUAL(expSerializedDocSize, op.getSerializedDocument()->size());
     }
 }
 
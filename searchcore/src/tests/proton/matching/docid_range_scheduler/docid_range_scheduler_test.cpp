@@ -139,6 +139,42 @@ TEST("require that the task scheduler acts as expected") {
     EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
 }
 
+TEST("require that the task scheduler stops assigning tasks when enough matches are reported") {
+    TaskDocidRangeScheduler scheduler(2, 5, 20, 10);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 5)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 9)));
+    scheduler.report_matches(0, 4);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(9, 13)));
+    EXPECT_FALSE(scheduler.stopped_early());
+    scheduler.report_matches(1, 6);
+    EXPECT_TRUE(scheduler.stopped_early());
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    scheduler.report_matches(0, 3);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 8u);
+    EXPECT_EQUAL(scheduler.total_size(1), 4u);
+}
+
+TEST("require that the task scheduler does not stop early when all tasks are assigned") {
+    TaskDocidRangeScheduler scheduler(1, 2, 10, 5);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 6)));
+    scheduler.report_matches(0, 2);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(6, 10)));
+    scheduler.report_matches(0, 3);
+    EXPECT_FALSE(scheduler.stopped_early());
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(10, 10)));
+}
+
+TEST("require that other schedulers never stop early") {
+    PartitionDocidRangeScheduler partition_scheduler(2, 20);
+    partition_scheduler.report_matches(0, 100);
+    EXPECT_FALSE(partition_scheduler.stopped_early());
+    AdaptiveDocidRangeScheduler adaptive_scheduler(2, 1, 20);
+    adaptive_scheduler.report_matches(0, 100);
+    EXPECT_FALSE(adaptive_scheduler.stopped_early());
+}
+
 TEST("require that the task scheduler protects against documents underflow") {
     TaskDocidRangeScheduler scheduler(2, 4, 0);
     TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,1)));
@@ -0,0 +1,263 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+
+#include <vespa/searchcore/proton/matching/blueprintbuilder.h>
+#include <vespa/searchcore/proton/matching/fakesearchcontext.h>
+#include <vespa/searchcore/proton/matching/filter_cache_key.h>
+#include <vespa/searchcore/proton/matching/matchdatareservevisitor.h>
+#include <vespa/searchcore/proton/matching/query.h>
+#include <vespa/searchcore/proton/matching/querynodes.h>
+#include <vespa/searchcore/proton/matching/resolveviewvisitor.h>
+#include <vespa/searchcore/proton/matching/viewresolver.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/searchlib/query/weight.h>
+#include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/searchlib/queryeval/filter_result_cache.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/searchlib/test/mock_attribute_manager.h>
+
+using proton::matching::BlueprintBuilder;
+using proton::matching::FakeSearchContext;
+using proton::matching::FilterCacheKey;
+using proton::matching::MatchDataReserveVisitor;
+using proton::matching::ProtonNodeTypes;
+using proton::matching::Query;
+using proton::matching::ResolveViewVisitor;
+using proton::matching::ViewResolver;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using search::attribute::IAttributeContext;
+using search::attribute::test::MockAttributeManager;
+using search::fef::FieldInfo;
+using search::fef::FieldType;
+using search::fef::MatchData;
+using search::fef::MatchDataLayout;
+using search::fef::test::IndexEnvironment;
+using search::query::Node;
+using search::query::QueryBuilder;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+using search::queryeval::Blueprint;
+using search::queryeval::FakeRequestContext;
+using search::queryeval::FakeResult;
+using search::queryeval::FilterResultCache;
+using search::queryeval::IntermediateBlueprint;
+using search::queryeval::SearchIterator;
+using search::queryeval::SimpleBlueprint;
+using search::queryeval::SimpleResult;
+
+using CollectionType = FieldInfo::CollectionType;
+
+const uint32_t docid_limit = 10;
+
+struct Fixture {
+    IndexEnvironment      idx_env;
+    MockAttributeManager  attr_manager;
+    AttributeVector::SP   attr_a;
+    IAttributeContext::UP attr_ctx;
+    FakeRequestContext    req_ctx;
+    FakeSearchContext     search_ctx;
+    FilterResultCache     cache;
+
+    Fixture()
+        : idx_env(),
+          attr_manager(),
+          attr_a(AttributeFactory::createAttribute("a", Config(BasicType::INT32))),
+          attr_ctx(attr_manager.createContext()),
+          req_ctx(attr_ctx.get()),
+          search_ctx(docid_limit),
+          cache(1000000)
+    {
+        idx_env.getFields().emplace_back(FieldType::ATTRIBUTE, CollectionType::SINGLE, "a", 0);
+        idx_env.getFields().emplace_back(FieldType::ATTRIBUTE, CollectionType::SINGLE, "b", 1);
+        idx_env.getFields().emplace_back(FieldType::ATTRIBUTE, CollectionType::SINGLE, "c", 2);
+        idx_env.getFields().emplace_back(FieldType::INDEX, CollectionType::SINGLE, "idx", 3);
+        add_attribute(attr_a);
+        add_attribute(AttributeFactory::createAttribute("b", Config(BasicType::INT32)));
+        add_attribute(AttributeFactory::createAttribute("c", Config(BasicType::INT32)));
+        search_ctx.attr().addResult("a", "1", FakeResult().doc(1).doc(3).doc(5))
+                         .addResult("b", "2", FakeResult().doc(3).doc(5).doc(7));
+    }
+
+    void add_attribute(const AttributeVector::SP &attr) {
+        attr_manager.addAttribute(attr);
+        attr->addDocs(docid_limit - 1);
+        attr->commit();
+    }
+
+    void feed_a() {
+        static_cast<IntegerAttribute &>(*attr_a).update(1, 42);
+        attr_a->commit();
+    }
+
+    Node::UP resolve(Node::UP node) {
+        ResolveViewVisitor resolver(ViewResolver(), idx_env);
+        node->accept(resolver);
+        return node;
+    }
+
+    Node::UP make_and(const char *first, const char *second) {
+        QueryBuilder<ProtonNodeTypes> builder;
+        builder.addAnd(2);
+        add_term(builder, first, 1);
+        add_term(builder, second, 2);
+        return resolve(builder.build());
+    }
+
+    Node::UP make_and_not(std::initializer_list<const char *> children) {
+        QueryBuilder<ProtonNodeTypes> builder;
+        builder.addAndNot(children.size());
+        int32_t id = 1;
+        for (const char *child: children) {
+            add_term(builder, child, id++);
+        }
+        return resolve(builder.build());
+    }
+
+    // term spec is "field:term"
+    static void add_term(QueryBuilder<ProtonNodeTypes> &builder, const char *spec, int32_t id) {
+        vespalib::string str(spec);
+        size_t colon = str.find(':');
+        builder.addStringTerm(str.substr(colon + 1), str.substr(0, colon), id, Weight(id * 100));
+    }
+
+    FilterCacheKey key(Node &node) {
+        return FilterCacheKey::create(node, req_ctx);
+    }
+
+    SimpleResult search(Node &node) {
+        MatchDataLayout mdl;
+        MatchDataReserveVisitor reserver(mdl);
+        node.accept(reserver);
+        Blueprint::UP blueprint = BlueprintBuilder::build(req_ctx, node, search_ctx, &cache);
+        EXPECT_TRUE(static_cast<IntermediateBlueprint &>(*blueprint).hasFilterCache());
+        MatchData::UP md = mdl.createMatchData();
+        for (uint32_t i = 0; i < md->getNumTermFields(); ++i) {
+            md->resolveTermField(i)->tagAsNotNeeded();
+        }
+        SearchIterator::UP iterator = blueprint->createSearch(*md, true);
+        SimpleResult result;
+        result.searchStrict(*iterator, docid_limit);
+        return result;
+    }
+
+    // search through a query restricted to the given active documents
+    SimpleResult search_active(Node &node, const SimpleResult &active) {
+        Query query;
+        EXPECT_TRUE(query.buildTree(StackDumpCreator::create(node), "", ViewResolver(), idx_env));
+        query.setFilterResultCache(&cache);
+        query.setWhiteListBlueprint(std::make_unique<SimpleBlueprint>(active));
+        MatchDataLayout mdl;
+        query.reserveHandles(req_ctx, search_ctx, mdl);
+        EXPECT_TRUE(!static_cast<const IntermediateBlueprint &>(*query.peekRoot()).hasFilterCache());
+        MatchData::UP md = mdl.createMatchData();
+        for (uint32_t i = 0; i < md->getNumTermFields(); ++i) {
+            md->resolveTermField(i)->tagAsNotNeeded();
+        }
+        query.optimize();
+        query.fetchPostings();
+        SearchIterator::UP iterator = query.createSearch(*md);
+        SimpleResult result;
+        result.searchStrict(*iterator, docid_limit);
+        return result;
+    }
+};
+
+TEST_F("require that children of AND and OR are ordered in the key", Fixture()) {
+    FilterCacheKey ab = f.key(*f.make_and("a:1", "b:2"));
+    FilterCacheKey ba = f.key(*f.make_and("b:2", "a:1"));
+    EXPECT_TRUE(ab.valid());
+    EXPECT_EQUAL(ab.key, ba.key);
+    EXPECT_EQUAL(ab.generation, ba.generation);
+    EXPECT_NOT_EQUAL(ab.key, f.key(*f.make_and("a:1", "b:3")).key);
+    EXPECT_NOT_EQUAL(ab.key, f.key(*f.make_and("a:1", "c:2")).key);
+
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addOr(2);
+    Fixture::add_term(builder, "b:2", 7);
+    Fixture::add_term(builder, "a:1", 8);
+    FilterCacheKey or_ba = f.key(*f.resolve(builder.build()));
+    EXPECT_TRUE(or_ba.valid());
+    EXPECT_NOT_EQUAL(ab.key, or_ba.key);
+    EXPECT_EQUAL("OR(string:a:1:1,string:b:1:2)", or_ba.key);
+}
+
+TEST_F("require that ANDNOT keeps its first child in place", Fixture()) {
+    FilterCacheKey abc = f.key(*f.make_and_not({"a:1", "b:2", "c:3"}));
+    FilterCacheKey acb = f.key(*f.make_and_not({"a:1", "c:3", "b:2"}));
+    FilterCacheKey bac = f.key(*f.make_and_not({"b:2", "a:1", "c:3"}));
+    EXPECT_TRUE(abc.valid());
+    EXPECT_EQUAL(abc.key, acb.key);
+    EXPECT_NOT_EQUAL(abc.key, bac.key);
+    EXPECT_EQUAL("ANDNOT(string:b:1:2,string:a:1:1,string:c:1:3)", bac.key);
+}
+
+TEST_F("require that subtrees searching index fields or unknown attributes have no key", Fixture()) {
+    EXPECT_TRUE(!f.key(*f.make_and("a:1", "idx:2")).valid());
+    EXPECT_TRUE(!f.key(*f.make_and("a:1", "unknown:2")).valid());
+}
+
+TEST_F("require that the key generation changes when a searched attribute is fed", Fixture()) {
+    FilterCacheKey before = f.key(*f.make_and("a:1", "b:2"));
+    FilterCacheKey untouched_before = f.key(*f.make_and("b:2", "c:3"));
+    f.feed_a();
+    FilterCacheKey after = f.key(*f.make_and("a:1", "b:2"));
+    EXPECT_EQUAL(before.key, after.key);
+    EXPECT_NOT_EQUAL(before.generation, after.generation);
+    EXPECT_EQUAL(untouched_before.generation, f.key(*f.make_and("b:2", "c:3")).generation);
+}
+
+TEST_F("require that cached filter subtrees are served from the cache until a searched attribute is fed", Fixture()) {
+    SimpleResult expect;
+    expect.addHit(3).addHit(5);
+    EXPECT_EQUAL(expect, f.search(*f.make_and("a:1", "b:2")));
+    EXPECT_EQUAL(0u, f.cache.get_stats().hits);
+    EXPECT_EQUAL(1u, f.cache.get_stats().misses);
+
+    // same filter with the children swapped is a cache hit; the
+    // changed backing result shows it is not evaluated again
+    f.search_ctx.attr().addResult("a", "1", FakeResult().doc(5));
+    EXPECT_EQUAL(expect, f.search(*f.make_and("b:2", "a:1")));
+    EXPECT_EQUAL(1u, f.cache.get_stats().hits);
+    EXPECT_EQUAL(1u, f.cache.get_stats().misses);
+
+    f.feed_a();
+    SimpleResult expect_after_feed;
+    expect_after_feed.addHit(5);
+    EXPECT_EQUAL(expect_after_feed, f.search(*f.make_and("a:1", "b:2")));
+    EXPECT_EQUAL(1u, f.cache.get_stats().hits);
+    EXPECT_EQUAL(2u, f.cache.get_stats().misses);
+    EXPECT_EQUAL(1u, f.cache.get_stats().entries);
+}
+
+TEST_F("require that filters restricted to active documents are not cached", Fixture()) {
+    f.search_ctx.attr().addResult("c", "3", FakeResult().doc(5));
+    SimpleResult active;
+    active.addHit(1).addHit(3).addHit(5);
+    SimpleResult expect;
+    expect.addHit(1).addHit(3);
+    EXPECT_EQUAL(expect, f.search_active(*f.make_and_not({"a:1", "c:3"}), active));
+
+    // deactivating the bucket of document 1 must be reflected by an
+    // otherwise identical query, even if no attribute is fed
+    SimpleResult active_after_flip;
+    active_after_flip.addHit(3).addHit(5);
+    SimpleResult expect_after_flip;
+    expect_after_flip.addHit(3);
+    EXPECT_EQUAL(expect_after_flip, f.search_active(*f.make_and_not({"a:1", "c:3"}), active_after_flip));
+    EXPECT_EQUAL(expect, f.search_active(*f.make_and_not({"a:1", "c:3"}), active));
+    EXPECT_EQUAL(0u, f.cache.get_stats().entries);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -12,6 +12,7 @@
 #include <vespa/searchcore/proton/matching/isearchcontext.h>
 #include <vespa/searchcore/proton/matching/matcher.h>
 #include <vespa/searchcore/proton/matching/querynodes.h>
+#include <vespa/searchcore/proton/matching/result_cache.h>
 #include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchcore/proton/matching/viewresolver.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
@@ -303,7 +304,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(SearchRequest::SP req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, SearchRequest::SP req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects;
         owned_objects.search_handler = std::make_shared<MySearchHandler>(matcher);
         owned_objects.context = std::make_unique<MatchContext>(std::make_unique<MockAttributeContext>(),
@@ -683,6 +687,157 @@ TEST("require that search session can be cached") {
     EXPECT_EQUAL("a", session->getSessionId());
 }
 
+TEST("require that repeated queries are answered from the result cache") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    SearchReply::UP first = world.performSearch(matcher, request, 1);
+    SearchReply::UP second = world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.queries());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+    EXPECT_EQUAL(first->totalHitCount, second->totalHitCount);
+    ASSERT_EQUAL(9u, second->hits.size());
+    for (size_t i = 0; i < second->hits.size(); ++i) {
+        EXPECT_EQUAL(first->hits[i].gid, second->hits[i].gid);
+        EXPECT_EQUAL(first->hits[i].metric, second->hits[i].metric);
+    }
+    SearchRequest::SP other = world.createSimpleRequest("f1", "spread");
+    other->propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "bar");
+    world.performSearch(matcher, other, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+}
+
+TEST("require that cached results are not used after the searchable data has changed") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, request, 1);
+    world.searchContext.setLimit(NUM_DOCS + 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheHits());
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(1u, world.matchingStats.resultCacheHits());
+}
+
+TEST("require that results larger than the result cache memory budget are not cached") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    world.set_property(indexproperties::matching::ResultCacheMaxMemory::NAME, "100");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, request, 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.queries());
+    EXPECT_EQUAL(2u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheHits());
+}
+
+TEST("require that the result cache evicts least recently used results to stay within its memory budget") {
+    SearchReply reply;
+    reply.hits.resize(10);
+    size_t entry_size;
+    {
+        ResultCache cache(10, 1000000);
+        cache.insert("a", 1, reply);
+        entry_size = cache.memoryUsed();
+    }
+    EXPECT_GREATER(entry_size, 10 * sizeof(SearchReply::Hit));
+    ResultCache cache(10, 2 * entry_size);
+    cache.insert("a", 1, reply);
+    cache.insert("b", 1, reply);
+    EXPECT_TRUE(cache.lookup("a", 1));
+    cache.insert("c", 1, reply);
+    EXPECT_EQUAL(2u, cache.size());
+    EXPECT_EQUAL(2 * entry_size, cache.memoryUsed());
+    EXPECT_TRUE(cache.lookup("a", 1));
+    EXPECT_TRUE(!cache.lookup("b", 1));
+    EXPECT_TRUE(cache.lookup("c", 1));
+    cache.insert("c", 1, reply);
+    EXPECT_EQUAL(2 * entry_size, cache.memoryUsed());
+    EXPECT_TRUE(!cache.lookup("c", 2));
+    EXPECT_EQUAL(entry_size, cache.memoryUsed());
+}
+
+TEST("require that the result cache is not used for queries with cached sessions") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheSize::NAME, "10");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->sessionId.push_back('a');
+    world.performSearch(matcher, request, 1);
+    world.performSearch(matcher, request, 1);
+    EXPECT_EQUAL(2u, world.matchingStats.queries());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheMisses());
+    EXPECT_EQUAL(0u, world.matchingStats.resultCacheHits());
+}
+
+TEST("require that matching stops early when docids are in static rank order") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::StaticRankOrderHits::NAME, "3");
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    SearchReply::UP reply = world.performSearch(request, 1);
+    EXPECT_EQUAL(3u, world.matchingStats.docsMatched());
+    ASSERT_EQUAL(3u, reply->hits.size());
+    EXPECT_EQUAL(document::DocumentId("doc::300").getGlobalId(), reply->hits[0].gid);
+    EXPECT_EQUAL(document::DocumentId("doc::100").getGlobalId(), reply->hits[2].gid);
+    EXPECT_NOT_EQUAL(0u, reply->coverage.getDegradeReason() & SearchReply::Coverage::MATCH_PHASE);
+    EXPECT_LESS(reply->coverage.getCovered(), reply->coverage.getActive());
+}
+
+TEST("require that static rank order early termination is not used after a document is re-fed to a lower lid") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::StaticRankOrderHits::NAME, "3");
+    EXPECT_TRUE(world.metaStore.isLidSpaceInFeedOrder());
+    document::DocumentId docId("doc::100");
+    document::BucketId bucketId(BucketFactory::getBucketId(docId));
+    EXPECT_TRUE(world.metaStore.remove(100));
+    world.metaStore.put(docId.getGlobalId(), bucketId, Timestamp(1u), 1, 100);
+    EXPECT_FALSE(world.metaStore.isLidSpaceInFeedOrder());
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    SearchReply::UP reply = world.performSearch(request, 1);
+    EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
+    ASSERT_EQUAL(9u, reply->hits.size());
+    EXPECT_EQUAL(document::DocumentId("doc::900").getGlobalId(), reply->hits[0].gid);
+    EXPECT_EQUAL(document::DocumentId("doc::800").getGlobalId(), reply->hits[1].gid);
+    EXPECT_EQUAL(document::DocumentId("doc::700").getGlobalId(), reply->hits[2].gid);
+    EXPECT_EQUAL(0u, reply->coverage.getDegradeReason());
+}
+
+TEST("require that static rank order early termination falls back to exact matching") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::StaticRankOrderHits::NAME, "3");
+    SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+    request->propertiesMap.lookupCreate(search::MapNames::RANK).add(indexproperties::matching::StaticRankOrderHits::NAME, "0");
+    SearchReply::UP reply = world.performSearch(request, 1);
+    EXPECT_EQUAL(9u, reply->hits.size());
+    EXPECT_EQUAL(0u, reply->coverage.getDegradeReason());
+    SearchRequest::SP sorted = world.createSimpleRequest("f1", "spread");
+    sorted->sortSpec = "+a1";
+    reply = world.performSearch(sorted, 1);
+    EXPECT_EQUAL(9u, reply->hits.size());
+    EXPECT_EQUAL(0u, reply->coverage.getDegradeReason());
+}
+
 TEST("require that getSummaryFeatures can use cached query setup") {
     MyWorld world;
     world.basicSetup();
@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchcore/proton/matching/partial_result.h>
 #include <vespa/vespalib/util/box.h>
+#include <vespa/vespalib/test/insertion_operators.h>
 
 using proton::matching::PartialResult;
 using namespace vespalib;
@@ -155,4 +156,83 @@ TEST("require that lower docid is preferred when using sortspec") {
     EXPECT_EQUAL(1u, res_a.hit(0)._docId);
 }
 
+struct TenPerGroup : PartialResult::DocumentGrouper {
+    uint64_t group(uint32_t docId) override { return docId / 10; }
+};
+
+PartialResult::UP make_grouped(size_t maxSize, bool hasSortData, uint32_t maxHitsPerGroup) {
+    auto result = std::make_unique<PartialResult>(maxSize, hasSortData);
+    result->limitHitsPerGroup(std::make_unique<TenPerGroup>(), maxHitsPerGroup);
+    return result;
+}
+
+std::vector<uint32_t> docids(const PartialResult &result) {
+    std::vector<uint32_t> ret;
+    for (size_t i = 0; i < result.size(); ++i) {
+        ret.push_back(result.hit(i)._docId);
+    }
+    return ret;
+}
+
+TEST("require that hits over the group limit are not added") {
+    auto res = make_grouped(10, false, 2);
+    EXPECT_TRUE(res->hasGroupLimit());
+    res->add(search::RankedHit(10, 6.0));
+    res->add(search::RankedHit(11, 5.0));
+    res->add(search::RankedHit(12, 4.0));
+    res->add(search::RankedHit(20, 3.0));
+    res->add(search::RankedHit(13, 2.0));
+    EXPECT_EQUAL(std::vector<uint32_t>({10, 11, 20}), docids(*res));
+}
+
+TEST("require that the group limit is applied to merged results") {
+    auto res_a = make_grouped(4, false, 2);
+    auto res_b = make_grouped(4, false, 2);
+    res_a->add(search::RankedHit(10, 9.0));
+    res_a->add(search::RankedHit(11, 8.0));
+    res_a->add(search::RankedHit(20, 3.0));
+    res_a->add(search::RankedHit(30, 2.0));
+    res_b->add(search::RankedHit(15, 7.0));
+    res_b->add(search::RankedHit(16, 6.0));
+    res_b->add(search::RankedHit(40, 5.0));
+    res_b->add(search::RankedHit(41, 4.0));
+    res_a->merge(*res_b);
+    EXPECT_EQUAL(std::vector<uint32_t>({10, 11, 40, 41}), docids(*res_a));
+}
+
+TEST("require that the group limit is applied to merged results with sort data") {
+    std::string a("a"), bb("bb"), ccc("ccc");
+    auto res_a = make_grouped(3, true, 1);
+    auto res_b = make_grouped(3, true, 1);
+    res_a->add(search::RankedHit(10, 0.0), PartialResult::SortRef(a.data(), a.size()));
+    res_a->add(search::RankedHit(20, 0.0), PartialResult::SortRef(ccc.data(), ccc.size()));
+    res_b->add(search::RankedHit(11, 0.0), PartialResult::SortRef(bb.data(), bb.size()));
+    res_b->add(search::RankedHit(30, 0.0), PartialResult::SortRef(ccc.data(), ccc.size()));
+    res_a->merge(*res_b);
+    EXPECT_EQUAL(std::vector<uint32_t>({10, 20, 30}), docids(*res_a));
+    EXPECT_EQUAL(7u, res_a->sortDataSize());
+}
+
+TEST("require that only as many sorted hits as fit in the result are needed for distinct groups") {
+    auto res = make_grouped(3, false, 2);
+    std::vector<search::RankedHit> hits({{10, 9.0}, {20, 8.0}, {30, 7.0}, {11, 6.0}, {40, 5.0}});
+    EXPECT_FALSE(res->wouldBeFilledBy(&hits[0], 2));
+    EXPECT_TRUE(res->wouldBeFilledBy(&hits[0], 3));
+    EXPECT_EQUAL(0u, res->size());
+}
+
+TEST("require that hits over the group limit do not help fill the result") {
+    auto res = make_grouped(3, false, 2);
+    std::vector<search::RankedHit> hits({{10, 9.0}, {11, 8.0}, {12, 7.0}, {13, 6.0}, {20, 5.0}});
+    EXPECT_FALSE(res->wouldBeFilledBy(&hits[0], 4));
+    EXPECT_TRUE(res->wouldBeFilledBy(&hits[0], 5));
+}
+
+TEST("require that results without a group limit are filled by as many hits as they hold") {
+    PartialResult res(3, false);
+    std::vector<search::RankedHit> hits({{10, 9.0}, {11, 8.0}, {12, 7.0}});
+    EXPECT_FALSE(res.wouldBeFilledBy(&hits[0], 2));
+    EXPECT_TRUE(res.wouldBeFilledBy(&hits[0], 3));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -77,6 +77,20 @@ GroupingManager::groupInRelevanceOrder(const RankedHit *searchResults, uint32_t
     }
 }
 
+uint32_t
+GroupingManager::getRelevanceOrderHitCount(uint32_t binSize)
+{
+    size_t hitCount(0);
+    GroupingContext::GroupingList &groupingList(_groupingContext.getGroupingList());
+    for (size_t i = 0; i < groupingList.size(); ++i) {
+        const Grouping & g = *groupingList[i];
+        if ( ! g.needResort() ) {
+            hitCount = std::max(hitCount, g.getMaxN(binSize));
+        }
+    }
+    return hitCount;
+}
+
 void
 GroupingManager::groupUnordered(const RankedHit *searchResults, uint32_t binSize, const search::BitVector * overflow)
 {
@@ -60,6 +60,15 @@ public:
      **/
     void groupInRelevanceOrder(const RankedHit *searchResults, uint32_t binSize);
 
+    /**
+     * Returns how many of the best ranked hits groupInRelevanceOrder
+     * will look at. Only this many hits need to be sorted before
+     * calling it.
+     *
+     * @param binSize size of search result array
+     **/
+    uint32_t getRelevanceOrderHitCount(uint32_t binSize);
+
     /**
      * Perform actual grouping on the given the results.
      * The results should be in fastest access order which is normally unsorted.
@@ -180,6 +180,16 @@ DocumentMetaStore::insert(DocId lid, const RawDocumentMetaData &metaData)
     if (!_gidToLidMap.insert(lid, BTreeNoLeafData(), comp)) {
         return false;
     }
+    DocId highestUsedLid = _lidAlloc.getHighestUsedLid();
+    if (lid < highestUsedLid) {
+        // lid reused after remove, newer document gets a lower lid
+        _lidsInFeedOrder.store(false, std::memory_order_relaxed);
+    } else if (validLidFast(highestUsedLid) &&
+               metaData.getTimestamp() < _metaDataStore[highestUsedLid].getTimestamp())
+    {
+        // older document gets a higher lid, same check as done on load
+        _lidsInFeedOrder.store(false, std::memory_order_relaxed);
+    }
     // flush writes to meta store rcu vector before new entry is visible
     // from frozen root or lid based scan
     std::atomic_thread_fence(std::memory_order_release);
@@ -296,10 +306,28 @@ DocumentMetaStore::onLoad()
 
     setNumDocs(_metaDataStore.size());
     setCommittedDocIdLimit(_metaDataStore.size());
+    checkLidsInFeedOrder();
 
     return true;
 }
 
+void
+DocumentMetaStore::checkLidsInFeedOrder()
+{
+    // Feed order is not saved, use timestamps as a conservative
+    // approximation. Documents updated after being fed make this fail.
+    Timestamp prevTimestamp(0);
+    bool inOrder = true;
+    for (DocId lid = 1; inOrder && lid < _metaDataStore.size(); ++lid) {
+        if (validLid(lid)) {
+            Timestamp timestamp = _metaDataStore[lid].getTimestamp();
+            inOrder = (timestamp >= prevTimestamp);
+            prevTimestamp = timestamp;
+        }
+    }
+    _lidsInFeedOrder.store(inOrder, std::memory_order_relaxed);
+}
+
 bool
 DocumentMetaStore::checkBuckets(const GlobalId &gid, const BucketId &bucketId,
                                 const TreeType::Iterator &itr, bool found)
@@ -450,7 +478,9 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwner::SP bucketDB,
       _bucketDB(bucketDB),
       _shrinkLidSpaceBlockers(0),
       _subDbType(subDbType),
-      _trackDocumentSizes(true)
+      _trackDocumentSizes(true),
+      _lidsInFeedOrder(true),
+      _activeLidsGeneration(0)
 {
     ensureSpace(0);         // lid 0 is reserved
     setCommittedDocIdLimit(1u);         // lid 0 is reserved
@@ -639,6 +669,7 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid)
     assert(fromLid < getCommittedDocIdLimit());
     assert(!validLid(toLid));
     assert(validLid(fromLid));
+    _lidsInFeedOrder.store(false, std::memory_order_relaxed);
     _lidAlloc.moveLidBegin(fromLid, toLid);
     _metaDataStore[toLid] = _metaDataStore[fromLid];
     const GlobalId & gid = getRawGid(fromLid);
@@ -962,6 +993,7 @@ DocumentMetaStore::updateActiveLids(const BucketId &bucketId, bool active)
         }
         _lidAlloc.updateActiveLids(lid, active);
     }
+    _activeLidsGeneration.fetch_add(1, std::memory_order_release);
 }
 
 void
@@ -15,6 +15,7 @@
 #include <vespa/searchlib/attribute/singlesmallnumericattribute.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/docstore/ibucketizer.h>
+#include <atomic>
 
 namespace proton::bucketdb {
     class SplitBucketSession;
@@ -71,11 +72,14 @@ private:
     uint32_t            _shrinkLidSpaceBlockers;
     const SubDbType     _subDbType;
     bool                _trackDocumentSizes;
+    std::atomic<bool>   _lidsInFeedOrder;
+    std::atomic<uint64_t> _activeLidsGeneration; // read by query threads
 
     DocId getFreeLid();
     DocId peekFreeLid();
     VESPA_DLL_LOCAL void ensureSpace(DocId lid);
     bool insert(DocId lid, const RawDocumentMetaData &metaData);
+    void checkLidsInFeedOrder();
 
     const GlobalId & getRawGid(DocId lid) const { return getRawMetaData(lid).getGid(); }
 
@@ -196,8 +200,19 @@ public:
     DocId   getNumUsedLids() const override { return _lidAlloc.getNumUsedLids(); }
     DocId getNumActiveLids() const override { return _lidAlloc.getNumActiveLids(); }
     search::LidUsageStats getLidUsageStats() const override;
+    bool isLidSpaceInFeedOrder() const override { return _lidsInFeedOrder.load(std::memory_order_relaxed); }
     search::queryeval::Blueprint::UP createWhiteListBlueprint() const override;
 
+    /**
+     * Implements search::attribute::IAttributeVector. Bucket activation
+     * changes the set of visible documents without a commit, and is
+     * therefore counted as well.
+     */
+    uint64_t getCommitGeneration() const override {
+        return DocumentMetaStoreAttribute::getCommitGeneration() +
+            _activeLidsGeneration.load(std::memory_order_acquire);
+    }
+
     /**
      * Implements search::AttributeVector
      */
@@ -2,6 +2,7 @@
 
 #include "putoperation.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using document::BucketId;
 using document::Document;
@@ -11,9 +12,22 @@ using vespalib::make_string;
 
 namespace proton {
 
+namespace {
+
+std::shared_ptr<const vespalib::nbostream>
+copySerializedDocument(const char *buf, size_t sz)
+{
+    auto stream = std::make_shared<vespalib::nbostream>(sz);
+    stream->write(buf, sz);
+    return stream;
+}
+
+}
+
 PutOperation::PutOperation()
     : DocumentOperation(FeedOperation::PUT),
-      _doc()
+      _doc(),
+      _serializedDoc()
 { }
 
 
@@ -23,7 +37,8 @@ PutOperation::PutOperation(const BucketId &bucketId,
     : DocumentOperation(FeedOperation::PUT,
                         bucketId,
                         timestamp),
-      _doc(doc)
+      _doc(doc),
+      _serializedDoc()
 { }
 
 PutOperation::~PutOperation() { }
@@ -36,6 +51,7 @@ PutOperation::serialize(vespalib::nbostream &os) const
     size_t oldSize = os.size();
     _doc->serialize(os);
     _serializedDocSize = os.size() - oldSize;
+    _serializedDoc = copySerializedDocument(os.peek() + oldSize, _serializedDocSize);
 }
 
 
@@ -45,8 +61,10 @@ PutOperation::deserialize(vespalib::nbostream &is,
 {
     DocumentOperation::deserialize(is, repo);
     size_t oldSize = is.size();
+    const char *docStart = is.peek();
     _doc.reset(new Document(repo, is));
     _serializedDocSize = oldSize - is.size();
+    _serializedDoc = copySerializedDocument(docStart, _serializedDocSize);
 }
 
 void
@@ -56,6 +74,7 @@ PutOperation::deserializeDocument(const DocumentTypeRepo &repo)
     _doc->serialize(stream);
     auto fixedDoc = std::make_shared<Document>(repo, stream);
     _doc = std::move(fixedDoc);
+    _serializedDoc.reset();
 }
 
 vespalib::string
@@ -3,12 +3,16 @@
 
 #include "documentoperation.h"
 
+namespace vespalib { class nbostream; }
+
 namespace proton {
 
 class PutOperation : public DocumentOperation
 {
     using DocumentSP = std::shared_ptr<document::Document>;
+    using SerializedDocumentSP = std::shared_ptr<const vespalib::nbostream>;
     DocumentSP _doc;
+    mutable SerializedDocumentSP _serializedDoc; // Set by serialize()/deserialize()
 
 public:
     PutOperation();
@@ -17,6 +21,12 @@ public:
                  const DocumentSP &doc);
     virtual ~PutOperation();
     const DocumentSP &getDocument() const { return _doc; }
+    /**
+     * Returns the document as serialized to or from the transaction log, or
+     * nullptr if the operation has not been serialized. Lets the document
+     * store reuse the bytes instead of serializing the document again.
+     */
+    const SerializedDocumentSP &getSerializedDocument() const { return _serializedDoc; }
     void assertValid() const;
     virtual void serialize(vespalib::nbostream &os) const override;
     virtual void deserialize(vespalib::nbostream &is,
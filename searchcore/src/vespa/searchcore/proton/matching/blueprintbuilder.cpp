@@ -4,6 +4,7 @@
 #include "blueprintbuilder.h"
 #include "termdatafromnode.h"
 #include "same_element_builder.h"
+#include "filter_cache_key.h"
 #include <vespa/searchlib/query/tree/customtypevisitor.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
@@ -56,13 +57,14 @@ class BlueprintBuilderVisitor :
 private:
     const IRequestContext & _requestContext;
     ISearchContext &_context;
+    FilterResultCache *_filterCache;
     Blueprint::UP   _result;
 
     void buildChildren(IntermediateBlueprint &parent,
                        const std::vector<search::query::Node *> &children)
     {
         for (size_t i = 0; i < children.size(); ++i) {
-            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context));
+            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context, _filterCache));
         }
     }
 
@@ -73,6 +75,24 @@ private:
         _result.reset(blueprint.release());
     }
 
+    template <typename NodeType>
+    void buildFilter(IntermediateBlueprint *b, NodeType &n) {
+        buildIntermediate(b, n);
+        if (_filterCache == nullptr) {
+            return;
+        }
+        FilterCacheKey key = FilterCacheKey::create(n, _requestContext);
+        if (key.valid()) {
+            // only cache the largest subtree
+            for (size_t i = 0; i < b->childCnt(); ++i) {
+                if (b->getChild(i).isIntermediate()) {
+                    static_cast<IntermediateBlueprint &>(b->getChild(i)).clearFilterCache();
+                }
+            }
+            b->setFilterCache(*_filterCache, key.key, key.generation);
+        }
+    }
+
     void buildWeakAnd(ProtonWeakAnd &n) {
         WeakAndBlueprint *wand = new WeakAndBlueprint(n.getMinHits());
         Blueprint::UP result(wand);
@@ -134,9 +154,9 @@ private:
     }
 
 protected:
-    void visit(ProtonAnd &n)         override { buildIntermediate(new AndBlueprint(), n); }
-    void visit(ProtonAndNot &n)      override { buildIntermediate(new AndNotBlueprint(), n); }
-    void visit(ProtonOr &n)          override { buildIntermediate(new OrBlueprint(), n); }
+    void visit(ProtonAnd &n)         override { buildFilter(new AndBlueprint(), n); }
+    void visit(ProtonAndNot &n)      override { buildFilter(new AndNotBlueprint(), n); }
+    void visit(ProtonOr &n)          override { buildFilter(new OrBlueprint(), n); }
     void visit(ProtonWeakAnd &n)     override { buildWeakAnd(n); }
     void visit(ProtonEquiv &n)       override { buildEquiv(n); }
     void visit(ProtonRank &n)        override { buildIntermediate(new RankBlueprint(), n); }
@@ -161,9 +181,11 @@ protected:
     void visit(ProtonRegExpTerm &n)      override { buildTerm(n); }
 
 public:
-    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context) :
+    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context,
+                            FilterResultCache *filterCache) :
         _requestContext(requestContext),
         _context(context),
+        _filterCache(filterCache),
         _result()
     { }
     Blueprint::UP build() {
@@ -179,7 +201,16 @@ BlueprintBuilder::build(const IRequestContext & requestContext,
                         search::query::Node &node,
                         ISearchContext &context)
 {
-    BlueprintBuilderVisitor visitor(requestContext, context);
+    return build(requestContext, node, context, nullptr);
+}
+
+search::queryeval::Blueprint::UP
+BlueprintBuilder::build(const IRequestContext & requestContext,
+                        search::query::Node &node,
+                        ISearchContext &context,
+                        FilterResultCache *filterCache)
+{
+    BlueprintBuilderVisitor visitor(requestContext, context, filterCache);
     node.accept(visitor);
     Blueprint::UP result = visitor.build();
     result->setDocIdLimit(context.getDocIdLimit());
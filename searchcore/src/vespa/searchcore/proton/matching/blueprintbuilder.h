@@ -6,6 +6,8 @@
 #include <vespa/searchlib/query/tree/node.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 
+namespace search::queryeval { class FilterResultCache; }
+
 namespace proton::matching {
 
 struct BlueprintBuilder {
@@ -17,6 +19,17 @@ struct BlueprintBuilder {
     build(const search::queryeval::IRequestContext & requestContext,
           search::query::Node &node,
           ISearchContext &context);
+
+    /**
+     * Same as above, but also let AND, ANDNOT and OR subtrees that
+     * only search attributes have their hits cached in the given
+     * filter result cache (if not nullptr).
+     */
+    static search::queryeval::Blueprint::UP
+    build(const search::queryeval::IRequestContext & requestContext,
+          search::query::Node &node,
+          ISearchContext &context,
+          search::queryeval::FilterResultCache *filterCache);
 };
 
 }
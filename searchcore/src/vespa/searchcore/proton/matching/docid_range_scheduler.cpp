@@ -30,6 +30,9 @@ DocidRange
 TaskDocidRangeScheduler::next_task(size_t thread_id)
 {
     std::lock_guard<std::mutex> guard(_lock);
+    if (_stopped) {
+        return DocidRange();
+    }
     DocidRange work = _splitter.get(_next_task);
     if (_next_task < _num_tasks) {
         ++_next_task;
@@ -40,16 +43,31 @@ TaskDocidRangeScheduler::next_task(size_t thread_id)
     return work;
 }
 
-TaskDocidRangeScheduler::TaskDocidRangeScheduler(size_t num_threads, size_t num_tasks, uint32_t docid_limit)
+TaskDocidRangeScheduler::TaskDocidRangeScheduler(size_t num_threads, size_t num_tasks, uint32_t docid_limit,
+                                                 size_t target_matches)
     : _lock(),
       _splitter(DocidRange(1, docid_limit), num_tasks),
       _next_task(0),
       _num_tasks(num_tasks),
       _assigned(num_threads, 0),
-      _unassigned(_splitter.full_range().size())
+      _unassigned(_splitter.full_range().size()),
+      _target_matches(target_matches),
+      _matches(0),
+      _stopped(false)
 {
 }
 
+void
+TaskDocidRangeScheduler::report_matches(size_t, size_t matches)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _matches += matches;
+    if ((_target_matches > 0) && (_matches >= _target_matches) && (_next_task < _num_tasks)) {
+        _stopped = true;
+        _unassigned.store(0, std::memory_order::memory_order_relaxed);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 size_t
@@ -104,6 +104,12 @@ public:
  * will return the remaining work to be done by the thread calling
  * it. The returned range is guaranteed to be a prefix of the range
  * passed as input to the 'share_range' function.
+ *
+ * The 'report_matches' function is called by a worker each time it
+ * is done searching a range, with the number of matches found in
+ * it. A scheduler may use this to stop handing out ranges when enough
+ * matches have been found. The 'stopped_early' function tells whether
+ * some of the docid space was left unassigned because of this.
  **/
 struct DocidRangeScheduler {
     typedef std::unique_ptr<DocidRangeScheduler> UP;
@@ -114,6 +120,8 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual void report_matches(size_t thread_id, size_t matches) = 0;
+    virtual bool stopped_early() const = 0;
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -135,12 +143,18 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    void report_matches(size_t, size_t) override {}
+    bool stopped_early() const override { return false; }
 };
 
 /**
  * A scheduler dividing the total docid space into tasks of equal
  * size. Tasks are assigned according to increasing docid to the first
- * worker thread that wants more to do.
+ * worker thread that wants more to do. If a target number of matches
+ * is given, no more tasks are assigned once the reported matches
+ * reach the target. Since all assigned tasks are completed, the
+ * searched docid space is then always a prefix of the total docid
+ * space.
  **/
 class TaskDocidRangeScheduler : public DocidRangeScheduler
 {
@@ -151,10 +165,13 @@ private:
     size_t              _num_tasks;
     std::vector<size_t> _assigned;
     std::atomic<size_t> _unassigned;
+    size_t              _target_matches;
+    size_t              _matches;
+    bool                _stopped;
 
     DocidRange next_task(size_t thread_id);
 public:
-    TaskDocidRangeScheduler(size_t num_threads, size_t num_tasks, uint32_t docid_limit);
+    TaskDocidRangeScheduler(size_t num_threads, size_t num_tasks, uint32_t docid_limit, size_t target_matches = 0);
     DocidRange first_range(size_t thread_id) override { return next_task(thread_id); }
     DocidRange next_range(size_t thread_id) override { return next_task(thread_id); }
     DocidRange total_span(size_t) const override { return _splitter.full_range(); }
@@ -162,6 +179,8 @@ public:
     size_t unassigned_size() const override { return _unassigned.load(std::memory_order::memory_order_relaxed); }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    void report_matches(size_t thread_id, size_t matches) override;
+    bool stopped_early() const override { return _stopped; }
 };
 
 /**
@@ -202,6 +221,8 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(_num_idle); }
     DocidRange share_range(size_t, DocidRange todo) override;
+    void report_matches(size_t, size_t) override {}
+    bool stopped_early() const override { return false; }
 };
 
 }
@@ -1,18 +1,26 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_scorer.h"
+#include <algorithm>
 
 using search::feature_t;
 using search::fef::FeatureResolver;
 using search::fef::RankProgram;
+using search::fef::BatchFeatureExecutor;
 using search::fef::LazyValue;
+using search::queryeval::HitCollector;
 using search::queryeval::SearchIterator;
 
+using Hit = HitCollector::Hit;
+
 namespace proton {
 namespace matching {
 
 namespace {
 
+// number of hits unpacked before the score is calculated for all of them
+constexpr size_t BATCH_SIZE = 64;
+
 LazyValue
 extractScoreFeature(const RankProgram &rankProgram)
 {
@@ -26,7 +34,10 @@ extractScoreFeature(const RankProgram &rankProgram)
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
     : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _batchExecutor(dynamic_cast<BatchFeatureExecutor *>(_scoreFeature.executor())),
+      _batchInputs(),
+      _batchResults()
 {
 }
 
@@ -36,5 +47,29 @@ DocumentScorer::score(uint32_t docId)
     return doScore(docId);
 }
 
+void
+DocumentScorer::scoreHits(std::vector<Hit> &hits)
+{
+    if ((_batchExecutor == nullptr) || (_batchExecutor->num_batch_inputs() == 0)) {
+        HitCollector::DocumentScorer::scoreHits(hits);
+        return;
+    }
+    size_t numInputs = _batchExecutor->num_batch_inputs();
+    _batchInputs.resize(BATCH_SIZE * numInputs);
+    _batchResults.resize(BATCH_SIZE);
+    for (size_t first = 0; first < hits.size(); first += BATCH_SIZE) {
+        size_t numDocs = std::min(BATCH_SIZE, hits.size() - first);
+        for (size_t i = 0; i < numDocs; ++i) {
+            uint32_t docId = hits[first + i].first;
+            _searchItr.unpack(docId);
+            _batchExecutor->gather_batch_inputs(docId, &_batchInputs[i * numInputs]);
+        }
+        _batchExecutor->execute_batch(&_batchInputs[0], numDocs, &_batchResults[0]);
+        for (size_t i = 0; i < numDocs; ++i) {
+            hits[first + i].second = _batchResults[i];
+        }
+    }
+}
+
 } // namespace proton::matching
 } // namespace proton
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/searchlib/fef/batch_feature_executor.h>
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
@@ -19,6 +20,9 @@ class DocumentScorer : public search::queryeval::HitCollector::DocumentScorer
 private:
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    search::fef::BatchFeatureExecutor *_batchExecutor;
+    std::vector<double> _batchInputs;
+    std::vector<double> _batchResults;
 
 public:
     DocumentScorer(search::fef::RankProgram &rankProgram,
@@ -30,6 +34,14 @@ public:
     }
 
     virtual search::feature_t score(uint32_t docId) override;
+
+    /**
+     * Scores the hits in blocks when the score is calculated by an
+     * executor supporting batch evaluation. Match data is unpacked
+     * and inputs gathered for each hit in a block before the score
+     * is calculated for all hits in the block together.
+     */
+    virtual void scoreHits(std::vector<search::queryeval::HitCollector::Hit> &hits) override;
 };
 
 } // namespace proton::matching
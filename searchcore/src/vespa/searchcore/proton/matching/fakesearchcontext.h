@@ -63,6 +63,10 @@ public:
     uint32_t getDocIdLimit() override {
         return _docIdLimit;
     }
+
+    uint64_t getIndexGeneration() override {
+        return _indexes->getSerialNum();
+    }
     virtual const vespalib::Doom & getDoom() const { return _doom; }
 };
 
@@ -0,0 +1,134 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_cache_key.h"
+#include "querynodes.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/query/tree/customtypevisitor.h>
+#include <vespa/searchlib/queryeval/irequestcontext.h>
+#include <vespa/searchlib/queryeval/termasstring.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+using search::query::Node;
+using search::queryeval::IRequestContext;
+using search::queryeval::termAsString;
+using vespalib::make_string;
+
+namespace proton::matching {
+
+namespace {
+
+class KeyBuilder : public search::query::CustomTypeVisitor<ProtonNodeTypes>
+{
+private:
+    const IRequestContext &_requestContext;
+    bool                   _valid;
+
+    void fail() { _valid = false; }
+
+    template <typename NodeType>
+    void buildIntermediate(const char *name, NodeType &n, size_t fixed_children) {
+        std::vector<vespalib::string> children;
+        for (Node *child: n.getChildren()) {
+            FilterCacheKey child_key = FilterCacheKey::create(*child, _requestContext);
+            if (!child_key.valid()) {
+                fail();
+                return;
+            }
+            children.push_back(child_key.key);
+            result.generation += child_key.generation;
+        }
+        if (children.empty()) {
+            fail();
+            return;
+        }
+        std::sort(children.begin() + std::min(fixed_children, children.size()), children.end());
+        result.key = name;
+        result.key.append("(");
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (i > 0) {
+                result.key.append(",");
+            }
+            result.key.append(children[i]);
+        }
+        result.key.append(")");
+    }
+
+    template <typename NodeType>
+    void buildTerm(const char *type, NodeType &n) {
+        if (n.numFields() == 0) {
+            fail();
+            return;
+        }
+        vespalib::string fields;
+        for (size_t i = 0; i < n.numFields(); ++i) {
+            const ProtonTermData::FieldEntry &field = n.field(i);
+            const search::attribute::IAttributeVector *attr = field.attribute_field
+                                                              ? _requestContext.getAttribute(field.field_name)
+                                                              : nullptr;
+            if (attr == nullptr) {
+                fail();
+                return;
+            }
+            result.generation += attr->getCommitGeneration();
+            if (i > 0) {
+                fields.append("|");
+            }
+            fields.append(field.field_name);
+        }
+        // length prefixed to keep terms from being mistaken for structure
+        vespalib::string term = termAsString(n);
+        result.key = make_string("%s:%s:%zu:", type, fields.c_str(), term.size());
+        result.key.append(term);
+    }
+
+    void visit(ProtonAnd &n)         override { buildIntermediate("AND", n, 0); }
+    void visit(ProtonAndNot &n)      override { buildIntermediate("ANDNOT", n, 1); }
+    void visit(ProtonOr &n)          override { buildIntermediate("OR", n, 0); }
+    void visit(ProtonWeakAnd &)      override { fail(); }
+    void visit(ProtonEquiv &)        override { fail(); }
+    void visit(ProtonRank &)         override { fail(); }
+    void visit(ProtonNear &)         override { fail(); }
+    void visit(ProtonONear &)        override { fail(); }
+    void visit(ProtonSameElement &)  override { fail(); }
+
+    void visit(ProtonWeightedSetTerm &) override { fail(); }
+    void visit(ProtonDotProduct &)      override { fail(); }
+    void visit(ProtonWandTerm &)        override { fail(); }
+    void visit(ProtonPhrase &)          override { fail(); }
+    void visit(ProtonLocationTerm &)    override { fail(); }
+    void visit(ProtonPredicateQuery &)  override { fail(); }
+
+    void visit(ProtonNumberTerm &n)      override { buildTerm("number", n); }
+    void visit(ProtonPrefixTerm &n)      override { buildTerm("prefix", n); }
+    void visit(ProtonRangeTerm &n)       override { buildTerm("range", n); }
+    void visit(ProtonStringTerm &n)      override { buildTerm("string", n); }
+    void visit(ProtonSubstringTerm &n)   override { buildTerm("substring", n); }
+    void visit(ProtonSuffixTerm &n)      override { buildTerm("suffix", n); }
+    void visit(ProtonRegExpTerm &n)      override { buildTerm("regexp", n); }
+
+public:
+    FilterCacheKey result;
+
+    KeyBuilder(const IRequestContext &requestContext)
+        : _requestContext(requestContext),
+          _valid(true),
+          result()
+    { }
+    bool valid() const { return _valid; }
+};
+
+} // namespace proton::matching::<unnamed>
+
+FilterCacheKey
+FilterCacheKey::create(Node &node, const IRequestContext &requestContext)
+{
+    KeyBuilder builder(requestContext);
+    node.accept(builder);
+    if (!builder.valid()) {
+        return FilterCacheKey();
+    }
+    return builder.result;
+}
+
+}
@@ -0,0 +1,32 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+
+namespace search::query { class Node; }
+namespace search::queryeval { class IRequestContext; }
+
+namespace proton::matching {
+
+/**
+ * Identifies the hits of a query subtree in the filter result
+ * cache. Only AND, ANDNOT and OR subtrees where all terms search
+ * attributes can be cached. The key is independent of the order of
+ * commutative children and of term ids and weights. The generation
+ * is the sum of the commit generations of the searched attributes,
+ * which changes whenever one of them is fed.
+ **/
+struct FilterCacheKey {
+    vespalib::string key;
+    uint64_t generation;
+
+    FilterCacheKey() : key(), generation(0) {}
+    bool valid() const { return !key.empty(); }
+
+    static FilterCacheKey create(search::query::Node &node,
+                                 const search::queryeval::IRequestContext &requestContext);
+};
+
+}
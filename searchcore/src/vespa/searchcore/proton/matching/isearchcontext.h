@@ -56,6 +56,14 @@ public:
      **/
     virtual uint32_t getDocIdLimit() = 0;
 
+    /**
+     * Obtain a generation that changes whenever changes to the index
+     * fields are made visible to searches through this context.
+     *
+     * @return index fields generation
+     **/
+    virtual uint64_t getIndexGeneration() = 0;
+
     /**
      * Deleting the context will trigger cleanup in the
      * implementation.
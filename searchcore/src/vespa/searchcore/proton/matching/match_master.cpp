@@ -39,9 +39,17 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
     }
 };
 
+// Number of tasks per thread used when searching docids in static rank order
+const uint32_t STATIC_RANK_ORDER_TASKS_PER_THREAD = 64;
+
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs, uint32_t staticRankOrderHits)
 {
+    if (staticRankOrderHits > 0) {
+        // tasks are searched in increasing docid order, stopping when enough hits are found
+        uint32_t numTasks = std::max(numSearchPartitions, numThreads * STATIC_RANK_ORDER_TASKS_PER_THREAD);
+        return std::make_unique<TaskDocidRangeScheduler>(numThreads, numTasks, numDocs, staticRankOrderHits);
+    }
     if (numSearchPartitions == 0) {
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
@@ -59,14 +67,16 @@ MatchMaster::match(const MatchParams &params,
                    const MatchToolsFactory &mtf,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   uint32_t staticRankOrderHits)
 {
     fastos::StopWatch query_latency_time;
     query_latency_time.start();
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize));
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs,
+                                                        staticRankOrderHits);
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
@@ -97,6 +107,7 @@ MatchMaster::match(const MatchParams &params,
     if (mtf.match_limiter().was_limited()) {
         _stats.limited_queries(1);        
     }
+    _stoppedEarly = scheduler->stopped_early();
     return reply;
 }
 
@@ -20,15 +20,30 @@ class MatchMaster
 {
 private:
     MatchingStats _stats;
+    bool          _stoppedEarly;
 
 public:
+    MatchMaster() : _stats(), _stoppedEarly(false) {}
     const MatchingStats & getStats() const { return _stats; }
+
+    /**
+     * Match the query. If 'staticRankOrderHits' is non-zero, docids
+     * are assumed to be ordered by decreasing static rank, and
+     * matching stops when at least that many hits have been found.
+     **/
     ResultProcessor::Result::UP match(const MatchParams &params,
                                       vespalib::ThreadBundle &threadBundle,
                                       const MatchToolsFactory &mtf,
                                       ResultProcessor &resultProcessor,
                                       uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      uint32_t staticRankOrderHits);
+
+    /**
+     * Whether the last match stopped before searching the whole
+     * docid space because enough hits were found.
+     **/
+    bool stoppedEarly() const { return _stoppedEarly; }
 
     static std::shared_ptr<search::FeatureSet>
     getFeatureSet(const MatchToolsFactory &matchToolsFactory,
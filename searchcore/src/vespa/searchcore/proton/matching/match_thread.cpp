@@ -185,7 +185,9 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
          docid_range = scheduler.next_range(thread_id))
     {
         if (!softDoomed) {
+            uint32_t matchesBefore = context.matches;
             uint32_t lastCovered = inner_match_loop<Strategy, do_rank, do_limit, do_share_work>(context, tools, docid_range);
+            scheduler.report_matches(thread_id, context.matches - matchesBefore);
             softDoomed = (lastCovered < docid_range.end);
             if (softDoomed) {
                 overtime = - context.timeLeft();
@@ -268,14 +270,15 @@ MatchThread::findMatches(MatchTools &tools)
     if (isFirstThread()) {
         LOG(debug, "SearchIterator after MultiBitVectorIteratorBase::optimize(): %s", tools.search().asString().c_str());
     }
-    HitCollector hits(matchParams.numDocs, matchParams.arraySize);
+    HitCollector hits(matchParams.numDocs, matchParams.arraySize,
+                      matchToolsFactory.createDocumentGrouper(), matchToolsFactory.hitDiversityMaxHitsPerGroup());
     match_loop_helper(tools, hits);
     if (tools.has_second_phase_rank()) {
         { // 2nd phase ranking
             tools.setup_second_phase();
             DocidRange docid_range = scheduler.total_span(thread_id);
             tools.search().initRange(docid_range.begin, docid_range.end);
-            auto sorted_hit_seq = matchToolsFactory.should_diversify()
+            auto sorted_hit_seq = (matchToolsFactory.should_diversify() || matchToolsFactory.should_diversify_hits())
                                   ? hits.getSortedHitSequence(matchParams.arraySize)
                                   : hits.getSortedHitSequence(matchParams.heapSize);
             WaitTimer select_best_timer(wait_time_s);
@@ -326,24 +329,37 @@ MatchThread::processResult(const Doom & hardDoom,
         man.groupUnordered(hits, numHits, bits);
     }
     if (hardDoom.doom()) return;
-    size_t sortLimit = hasGrouping ? numHits : context.result->maxSize();
+    PartialResult &pr = *context.result;
+    size_t sortLimit = pr.maxSize();
+    if (hasGrouping) {
+        // groupings that resort their input do not need the hits in relevance order
+        search::grouping::GroupingManager man(*context.grouping);
+        sortLimit = std::max(sortLimit, size_t(man.getRelevanceOrderHitCount(numHits)));
+    }
     result->sort(*context.sort->sorter, sortLimit);
+    if (pr.hasGroupLimit()) {
+        // hits over the group limit are skipped, so sort further until
+        // the sorted hits are enough to fill the result
+        while ((sortLimit < numHits) && !pr.wouldBeFilledBy(hits, sortLimit)) {
+            sortLimit = std::min(numHits, std::max(size_t(1), 2 * sortLimit));
+            result->sort(*context.sort->sorter, sortLimit);
+        }
+    }
     if (hardDoom.doom()) return;
     if (hasGrouping) {
         search::grouping::GroupingManager man(*context.grouping);
         man.groupInRelevanceOrder(hits, numHits);
     }
     if (hardDoom.doom()) return;
-    PartialResult &pr = *context.result;
     pr.totalHits(totalHits);
-    size_t maxHits = std::min(numHits, pr.maxSize());
+    size_t maxHits = std::min(numHits, sortLimit);
     if (pr.hasSortData()) {
         FastS_SortSpec &spec = context.sort->sortSpec;
-        for (size_t i = 0; i < maxHits; ++i) {
+        for (size_t i = 0; (i < maxHits) && (pr.size() < pr.maxSize()); ++i) {
             pr.add(hits[i], spec.getSortRef(i));
         }
     } else {
-        for (size_t i = 0; i < maxHits; ++i) {
+        for (size_t i = 0; (i < maxHits) && (pr.size() < pr.maxSize()); ++i) {
             pr.add(hits[i]);
         }
         if ((bits != nullptr) && (pr.size() < pr.maxSize())) {
@@ -405,6 +421,11 @@ MatchThread::run()
     match_time.stop();
     match_time_s = match_time.elapsed().sec();
     resultContext = resultProcessor.createThreadContext(matchTools->getHardDoom(), thread_id, _distributionKey);
+    if (matchToolsFactory.should_diversify_hits()) {
+        if (auto grouper = matchToolsFactory.createDocumentGrouper()) {
+            resultContext->result->limitHitsPerGroup(std::move(grouper), matchToolsFactory.hitDiversityMaxHitsPerGroup());
+        }
+    }
     {
         WaitTimer get_token_timer(wait_time_s);
         QueryLimiter::Token::UP processToken(
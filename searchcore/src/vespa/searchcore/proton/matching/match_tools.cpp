@@ -13,6 +13,8 @@ LOG_SETUP(".proton.matching.match_tools");
 using search::attribute::IAttributeContext;
 using search::queryeval::IRequestContext;
 using search::queryeval::IDiversifier;
+using search::queryeval::HitCollector;
+using search::queryeval::FilterResultCache;
 using search::attribute::diversity::DiversityFilter;
 using search::attribute::BasicType;
 
@@ -158,7 +160,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const IIndexEnvironment    & indexEnv,
                   const RankSetup            & rankSetup,
                   const Properties           & rankProperties,
-                  const Properties           & featureOverrides)
+                  const Properties           & featureOverrides,
+                  FilterResultCache          * filterResultCache)
     : _queryLimiter(queryLimiter),
       _requestContext(softDoom, attributeContext),
       _hardDoom(hardDoom),
@@ -169,18 +172,28 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
       _diversityParams(),
+      _hitDiversityAttribute(),
+      _hitDiversityMaxHitsPerGroup(0),
       _valid(_query.buildTree(queryStack, location, viewResolver, indexEnv))
 {
     if (_valid) {
         _query.extractTerms(_queryEnv.terms());
         _query.extractLocations(_queryEnv.locations());
         _query.setWhiteListBlueprint(metaStore.createWhiteListBlueprint());
+        _query.setFilterResultCache(filterResultCache);
         _query.reserveHandles(_requestContext, searchContext, _mdl);
         _query.optimize();
         _query.fetchPostings();
         _query.freeze();
         _rankSetup.prepareSharedState(_queryEnv, _queryEnv.getObjectStore());
         _diversityParams = extractDiversityParams(_rankSetup, rankProperties);
+        _hitDiversityAttribute = hitcollector::DiversityAttribute::lookup(rankProperties, _rankSetup.getHitDiversityAttribute());
+        _hitDiversityMaxHitsPerGroup = hitcollector::DiversityMaxHitsPerGroup::lookup(rankProperties, _rankSetup.getHitDiversityMaxHitsPerGroup());
+        if (should_diversify() && should_diversify_hits() && (_hitDiversityAttribute != _diversityParams.attribute)) {
+            LOG(warning, "Hit diversity on '%s' is not used when selecting hits for second phase ranking, "
+                "match phase diversity on '%s' is used instead.",
+                _hitDiversityAttribute.c_str(), _diversityParams.attribute.c_str());
+        }
         DegradationParams degradationParams = extractDegradationParams(_rankSetup, rankProperties);
 
         if (degradationParams.enabled()) {
@@ -207,6 +220,14 @@ std::unique_ptr<IDiversifier>
 MatchToolsFactory::createDiversifier(uint32_t heapSize) const
 {
     if ( !_diversityParams.enabled() ) {
+        if (should_diversify_hits()) {
+            // keep the group limit when selecting hits for re-ranking across threads
+            auto attr = _requestContext.getAttribute(_hitDiversityAttribute);
+            if (attr) {
+                return DiversityFilter::create(*attr, heapSize, _hitDiversityMaxHitsPerGroup,
+                                               std::numeric_limits<size_t>::max(), true);
+            }
+        }
         return std::unique_ptr<IDiversifier>();
     }
     auto attr = _requestContext.getAttribute(_diversityParams.attribute);
@@ -215,10 +236,27 @@ MatchToolsFactory::createDiversifier(uint32_t heapSize) const
         return std::unique_ptr<IDiversifier>();
     }
     size_t max_per_group = heapSize/_diversityParams.min_groups;
+    if (should_diversify_hits() && (_hitDiversityAttribute == _diversityParams.attribute)) {
+        max_per_group = std::min(max_per_group, size_t(_hitDiversityMaxHitsPerGroup));
+    }
     return DiversityFilter::create(*attr, heapSize, max_per_group, _diversityParams.min_groups,
                                    _diversityParams.cutoff_strategy == DiversityParams::CutoffStrategy::STRICT);
 }
 
+std::unique_ptr<HitCollector::DocumentGrouper>
+MatchToolsFactory::createDocumentGrouper() const
+{
+    if ( !should_diversify_hits() ) {
+        return std::unique_ptr<HitCollector::DocumentGrouper>();
+    }
+    auto attr = _requestContext.getAttribute(_hitDiversityAttribute);
+    if ( !attr) {
+        LOG(warning, "Skipping hit diversity due to no %s attribute.", _hitDiversityAttribute.c_str());
+        return std::unique_ptr<HitCollector::DocumentGrouper>();
+    }
+    return search::attribute::diversity::create_document_grouper(*attr);
+}
+
 std::unique_ptr<AttributeOperationTask>
 MatchToolsFactory::createTask(vespalib::stringref attribute, vespalib::stringref operation) const {
     return (!attribute.empty() && ! operation.empty())
@@ -15,6 +15,7 @@
 #include <vespa/searchlib/fef/fef.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
 #include <vespa/searchlib/queryeval/idiversifier.h>
+#include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/vespalib/util/doom.h>
 #include <vespa/vespalib/util/clock.h>
 
@@ -98,6 +99,8 @@ private:
     const search::fef::RankSetup    & _rankSetup;
     const search::fef::Properties   & _featureOverrides;
     DiversityParams                   _diversityParams;
+    vespalib::string                  _hitDiversityAttribute;
+    uint32_t                          _hitDiversityMaxHitsPerGroup;
     bool                              _valid;
 
     std::unique_ptr<AttributeOperationTask>
@@ -118,13 +121,17 @@ public:
                       const search::fef::IIndexEnvironment &indexEnv,
                       const search::fef::RankSetup &rankSetup,
                       const search::fef::Properties &rankProperties,
-                      const search::fef::Properties &featureOverrides);
+                      const search::fef::Properties &featureOverrides,
+                      search::queryeval::FilterResultCache *filterResultCache);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
     MatchTools::UP createMatchTools() const;
     bool should_diversify() const { return _diversityParams.enabled(); }
     std::unique_ptr<search::queryeval::IDiversifier> createDiversifier(uint32_t heapSize) const;
+    bool should_diversify_hits() const { return (_hitDiversityMaxHitsPerGroup > 0) && !_hitDiversityAttribute.empty(); }
+    uint32_t hitDiversityMaxHitsPerGroup() const { return _hitDiversityMaxHitsPerGroup; }
+    std::unique_ptr<search::queryeval::HitCollector::DocumentGrouper> createDocumentGrouper() const;
     search::queryeval::Blueprint::HitEstimate estimate() const { return _query.estimate(); }
     bool has_first_phase_rank() const { return !_rankSetup.getFirstPhaseRank().empty(); }
     std::unique_ptr<AttributeOperationTask> createOnMatchTask() const;
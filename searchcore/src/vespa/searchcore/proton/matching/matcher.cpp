@@ -6,6 +6,7 @@
 #include "match_tools.h"
 #include "match_params.h"
 #include "matcher.h"
+#include "result_cache.h"
 #include "sessionmanager.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/engine/errorcodes.h>
@@ -14,6 +15,7 @@
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/searchlib/features/setup.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
+#include <vespa/searchlib/queryeval/filter_result_cache.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.matcher");
@@ -27,6 +29,7 @@ using search::LidUsageStats;
 using search::FeatureSet;
 using search::attribute::IAttributeContext;
 using search::fef::MatchDataLayout;
+using search::queryeval::FilterResultCache;
 using search::fef::MatchData;
 using search::fef::indexproperties::hitcollector::HeapSize;
 using search::queryeval::Blueprint;
@@ -49,6 +52,7 @@ struct StupidMetaStore : search::IDocumentMetaStore {
     DocId getNumActiveLids() const override { return 0; }
     uint64_t getCurrentGeneration() const override { return 0; }
     LidUsageStats getLidUsageStats() const override { return LidUsageStats(); }
+    bool isLidSpaceInFeedOrder() const override { return false; }
     Blueprint::UP createWhiteListBlueprint() const override { return Blueprint::UP(); }
     void foreach(const search::IGidToLidMapperVisitor &) const override { }
 };
@@ -134,7 +138,9 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
       _stats(),
       _clock(clock),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey)
+      _distributionKey(distributionKey),
+      _filterResultCache(),
+      _resultCache()
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -143,8 +149,18 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
     if (!_rankSetup->compile()) {
         throw vespalib::IllegalArgumentException("failed to compile rank setup", VESPA_STRLOC);
     }
+    uint32_t filterCacheMaxMemory = FilterCacheMaxMemory::lookup(props);
+    if (filterCacheMaxMemory > 0) {
+        _filterResultCache = std::make_unique<FilterResultCache>(filterCacheMaxMemory);
+    }
+    uint32_t resultCacheSize = ResultCacheSize::lookup(props);
+    if (resultCacheSize > 0) {
+        _resultCache = std::make_unique<ResultCache>(resultCacheSize, ResultCacheMaxMemory::lookup(props));
+    }
 }
 
+Matcher::~Matcher() = default;
+
 MatchingStats
 Matcher::getStats()
 {
@@ -177,7 +193,8 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
     return std::make_unique<MatchToolsFactory>(_queryLimiter, vespalib::Doom(_clock, safeDoom),
                                                vespalib::Doom(_clock, request.getTimeOfDoom()), searchContext,
                                                attrContext, request.getStackRef(), request.location, _viewResolver,
-                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides);
+                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides,
+                                               _filterResultCache.get());
 }
 
 SearchReply::UP
@@ -230,6 +247,21 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                 }
             }
         }
+        bool useResultCache = (_resultCache && !shouldCacheSearchSession && !shouldCacheGroupingSession);
+        vespalib::string resultCacheKey;
+        uint64_t visibilityGeneration = 0;
+        if (useResultCache) {
+            resultCacheKey = ResultCache::makeKey(request);
+            visibilityGeneration = ResultCache::getVisibilityGeneration(searchContext, attrContext);
+            SearchReply::UP cachedReply = _resultCache->lookup(resultCacheKey, visibilityGeneration);
+            if (cachedReply) {
+                total_matching_time.stop();
+                my_stats.queries(1).resultCacheHits(1).queryLatency(total_matching_time.elapsed().sec());
+                std::lock_guard<std::mutex> guard(_statsLock);
+                _stats.add(my_stats);
+                return cachedReply;
+            }
+        }
         const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
         if (shouldCacheSearchSession) {
             owned_objects.feature_overrides = std::make_unique<Properties>(*feature_overrides);
@@ -258,12 +290,27 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         MatchMaster master;
         uint32_t numSearchPartitions = NumSearchPartitions::lookup(rankProperties,
                                                                    _rankSetup->getNumSearchPartitions());
+        uint32_t staticRankOrderHits = StaticRankOrderHits::lookup(rankProperties,
+                                                                   _rankSetup->getStaticRankOrderHits());
+        if (!request.sortSpec.empty() || !groupingContext.empty()) {
+            // sorting and grouping need all hits, fall back to exact matching
+            staticRankOrderHits = 0;
+        }
+        if ((staticRankOrderHits > 0) && !metaStore.isLidSpaceInFeedOrder()) {
+            // lids have been reused or compacted, docid order is no longer static rank order
+            LOG(debug, "lid space not in feed order, ignoring static rank order hits (%u)", staticRankOrderHits);
+            staticRankOrderHits = 0;
+        }
         ResultProcessor::Result::UP result = master.match(params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numSearchPartitions);
+                                                          _distributionKey, numSearchPartitions, staticRankOrderHits);
+        bool stoppedEarly = master.stoppedEarly();
         my_stats = MatchMaster::getStats(std::move(master));
+        if (useResultCache) {
+            my_stats.resultCacheMisses(1);
+        }
 
         bool wasLimited = mtf->match_limiter().was_limited();
-        size_t spaceEstimate = (my_stats.softDoomed())
+        size_t spaceEstimate = (my_stats.softDoomed() || stoppedEarly)
                                ? my_stats.docidSpaceCovered()
                                : mtf->match_limiter().getDocIdSpaceEstimate();
         uint32_t estHits = mtf->estimate().estHits;
@@ -296,14 +343,17 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         //TODO this should be calculated with ClusterState calculator.
         coverage.setSoonActive(numActiveLids);
         coverage.setCovered(covered);
-        if (wasLimited) {
+        if (wasLimited || stoppedEarly) {
             coverage.degradeMatchPhase();
-            LOG(debug, "was limited, degraded from match phase");
+            LOG(debug, "was limited or stopped early, degraded from match phase");
         }
         if (my_stats.softDoomed()) {
             coverage.degradeTimeout();
             LOG(debug, "soft doomed, degraded from timeout covered = %lu", coverage.getCovered());
         }
+        if (useResultCache && (reply->errorCode == 0) && (coverage.getDegradeReason() == 0)) {
+            _resultCache->insert(resultCacheKey, visibilityGeneration, *reply);
+        }
         LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%ld , rankprofile=%s",
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount,
             request.ranking.c_str());
@@ -32,12 +32,14 @@ namespace search::engine {
     class SearchReply;
 }
 namespace search { struct IDocumentMetaStore; }
+namespace search::queryeval { class FilterResultCache; }
 
 namespace proton::matching {
 
 class ISearchContext;
 class SessionManager;
 class MatchToolsFactory;
+class ResultCache;
 
 /**
  * The Matcher is responsible for performing searches.
@@ -57,6 +59,8 @@ private:
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    std::unique_ptr<search::queryeval::FilterResultCache> _filterResultCache;
+    std::unique_ptr<ResultCache>  _resultCache;
 
     search::FeatureSet::SP
     getFeatureSet(const DocsumRequest & req, ISearchContext & searchCtx, IAttributeContext & attrCtx,
@@ -89,6 +93,7 @@ public:
     Matcher(const search::index::Schema &schema, const Properties &props,
             const vespalib::Clock &clock, QueryLimiter &queryLimiter,
             const IConstantValueRepo &constantValueRepo, uint32_t distributionKey);
+    ~Matcher();
 
     const search::fef::IIndexEnvironment &get_index_env() const { return _indexEnv; }
 
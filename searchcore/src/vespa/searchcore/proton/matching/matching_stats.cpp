@@ -22,6 +22,8 @@ constexpr double MAX_CHANGE_FACTOR = 5;
 MatchingStats::MatchingStats()
     : _queries(0),
       _limited_queries(0),
+      _resultCacheHits(0),
+      _resultCacheMisses(0),
       _docidSpaceCovered(0),
       _docsMatched(0),
       _docsRanked(0),
@@ -61,6 +63,8 @@ MatchingStats::add(const MatchingStats &rhs)
 {
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _resultCacheHits += rhs._resultCacheHits;
+    _resultCacheMisses += rhs._resultCacheMisses;
 
     _docidSpaceCovered += rhs._docidSpaceCovered;
     _docsMatched += rhs._docsMatched;
@@ -118,6 +118,8 @@ public:
 private:
     size_t                 _queries;
     size_t                 _limited_queries;
+    size_t                 _resultCacheHits;
+    size_t                 _resultCacheMisses;
     size_t                 _docidSpaceCovered;
     size_t                 _docsMatched;
     size_t                 _docsRanked;
@@ -146,6 +148,12 @@ public:
     MatchingStats &limited_queries(size_t value) { _limited_queries = value; return *this; }
     size_t limited_queries() const { return _limited_queries; }
 
+    MatchingStats &resultCacheHits(size_t value) { _resultCacheHits = value; return *this; }
+    size_t resultCacheHits() const { return _resultCacheHits; }
+
+    MatchingStats &resultCacheMisses(size_t value) { _resultCacheMisses = value; return *this; }
+    size_t resultCacheMisses() const { return _resultCacheMisses; }
+
     MatchingStats &docidSpaceCovered(size_t value) { _docidSpaceCovered = value; return *this; }
     size_t docidSpaceCovered() const { return _docidSpaceCovered; }
 
@@ -105,7 +105,10 @@ PartialResult::PartialResult(size_t maxSize_in, bool hasSortData_in)
       _maxSize(maxSize_in),
       _totalHits(0),
       _hasSortData(hasSortData_in),
-      _sortDataSize(0)
+      _sortDataSize(0),
+      _grouper(),
+      _maxHitsPerGroup(0),
+      _groupHits()
 {
     _hits.reserve(_maxSize);
     if (_hasSortData) {
@@ -115,16 +118,86 @@ PartialResult::PartialResult(size_t maxSize_in, bool hasSortData_in)
 
 PartialResult::~PartialResult() {}
 
+void
+PartialResult::limitHitsPerGroup(std::unique_ptr<DocumentGrouper> grouper, uint32_t maxHitsPerGroup)
+{
+    assert(_hits.empty());
+    _grouper = std::move(grouper);
+    _maxHitsPerGroup = maxHitsPerGroup;
+}
+
+bool
+PartialResult::admit(uint32_t docId)
+{
+    if (_hits.size() >= _maxSize) {
+        return false;
+    }
+    uint32_t &groupHits = _groupHits[_grouper->group(docId)];
+    if (groupHits >= _maxHitsPerGroup) {
+        return false;
+    }
+    ++groupHits;
+    return true;
+}
+
+bool
+PartialResult::wouldBeFilledBy(const search::RankedHit *hits, size_t numHits)
+{
+    if (!_grouper) {
+        return (numHits >= _maxSize);
+    }
+    vespalib::hash_map<uint64_t, uint32_t> groupHits;
+    size_t kept = 0;
+    for (size_t i = 0; (i < numHits) && (kept < _maxSize); ++i) {
+        uint32_t &hitsInGroup = groupHits[_grouper->group(hits[i]._docId)];
+        if (hitsInGroup < _maxHitsPerGroup) {
+            ++hitsInGroup;
+            ++kept;
+        }
+    }
+    return (kept >= _maxSize);
+}
+
+void
+PartialResult::applyGroupLimit()
+{
+    _groupHits.clear();
+    _sortDataSize = 0;
+    size_t dst = 0;
+    for (size_t src = 0; (src < _hits.size()) && (dst < _maxSize); ++src) {
+        uint32_t &groupHits = _groupHits[_grouper->group(_hits[src]._docId)];
+        if (groupHits < _maxHitsPerGroup) {
+            ++groupHits;
+            _hits[dst] = _hits[src];
+            if (_hasSortData) {
+                _sortData[dst] = _sortData[src];
+                _sortDataSize += _sortData[dst].second;
+            }
+            ++dst;
+        }
+    }
+    _hits.resize(dst);
+    if (_hasSortData) {
+        _sortData.resize(dst);
+    }
+}
+
 void
 PartialResult::merge(Source &rhs)
 {
     PartialResult &r = static_cast<PartialResult&>(rhs);
     assert(_hasSortData == r._hasSortData);
     _totalHits += r._totalHits;
+    // with a group limit, hits from one side may be dropped after the
+    // merge, so keep all of them until the limit has been applied
+    size_t maxHits = _grouper ? (_hits.size() + r._hits.size()) : _maxSize;
     if (_hasSortData) {
-        _sortDataSize = mergeHits(_maxSize, _hits, _sortData, r._hits, r._sortData);
+        _sortDataSize = mergeHits(maxHits, _hits, _sortData, r._hits, r._sortData);
     } else {
-        mergeHits(_maxSize, _hits, r._hits);
+        mergeHits(maxHits, _hits, r._hits);
+    }
+    if (_grouper) {
+        applyGroupLimit();
     }
 }
 
@@ -3,7 +3,9 @@
 #pragma once
 
 #include <vespa/vespalib/util/dual_merge_director.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/searchlib/common/rankedhit.h>
+#include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vector>
 
 namespace proton {
@@ -18,6 +20,7 @@ class PartialResult : public vespalib::DualMergeDirector::Source
 public:
     using UP = std::unique_ptr<PartialResult>;
     using SortRef = std::pair<const char *, size_t>;
+    using DocumentGrouper = search::queryeval::HitCollector::DocumentGrouper;
 
 private:
     std::vector<search::RankedHit> _hits;
@@ -26,6 +29,12 @@ private:
     size_t                         _totalHits;
     bool                           _hasSortData;
     size_t                         _sortDataSize;
+    std::unique_ptr<DocumentGrouper> _grouper;
+    uint32_t                       _maxHitsPerGroup;
+    vespalib::hash_map<uint64_t, uint32_t> _groupHits;
+
+    bool admit(uint32_t docId);
+    void applyGroupLimit();
 
 public:
     PartialResult(size_t maxSize_in, bool hasSortData_in);
@@ -38,12 +47,34 @@ public:
     const search::RankedHit &hit(size_t i) const { return _hits[i]; }
     const SortRef &sortData(size_t i) const { return _sortData[i]; }
     void totalHits(size_t th) { _totalHits = th; }
+
+    /**
+     * Keep at most maxHitsPerGroup hits from each group, both when
+     * adding hits and when merging with other partial results. Hits
+     * beyond the limit are dropped, so a result may end up with fewer
+     * than maxSize hits.
+     **/
+    void limitHitsPerGroup(std::unique_ptr<DocumentGrouper> grouper, uint32_t maxHitsPerGroup);
+    bool hasGroupLimit() const { return bool(_grouper); }
+
+    /**
+     * Check whether adding the given hits in order to an empty result
+     * would fill it up, taking the group limit into account.
+     **/
+    bool wouldBeFilledBy(const search::RankedHit *hits, size_t numHits);
+
     void add(const search::RankedHit &h) {
         assert(!_hasSortData);
+        if (_grouper && !admit(h._docId)) {
+            return;
+        }
         _hits.push_back(h);
     }
     void add(const search::RankedHit &h, const SortRef &sd) {
         assert(_hasSortData);
+        if (_grouper && !admit(h._docId)) {
+            return;
+        }
         _hits.push_back(h);
         _sortData.push_back(sd);
         _sortDataSize += sd.second;
@@ -97,6 +97,19 @@ lastConsequtiveRankOrAndNot(Blueprint * blueprint) {
     return prev;
 }
 
+// The white list is inserted below all of these, so their hits
+// depend on which buckets are active. That is not part of the filter
+// cache key, and changes without bumping any commit generation.
+void
+clearFilterCacheAboveWhiteList(Blueprint * blueprint) {
+    for (IntermediateBlueprint * curr = asRankOrAndNot(blueprint);
+         curr != nullptr;
+         curr = asRankOrAndNot(&curr->getChild(0)))
+    {
+        curr->clearFilterCache();
+    }
+}
+
 }  // namespace
 
 Query::Query() = default;
@@ -146,12 +159,13 @@ Query::reserveHandles(const IRequestContext & requestContext, ISearchContext &co
     MatchDataReserveVisitor reserve_visitor(mdl);
     _query_tree->accept(reserve_visitor);
 
-    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context);
+    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context, _filterResultCache);
     LOG(debug, "original blueprint:\n%s\n", _blueprint->asString().c_str());
     if (_whiteListBlueprint) {
         auto andBlueprint = std::make_unique<AndBlueprint>();
         IntermediateBlueprint * rankOrAndNot = lastConsequtiveRankOrAndNot(_blueprint.get());
         if (rankOrAndNot != nullptr) {
+            clearFilterCacheAboveWhiteList(_blueprint.get());
             (*andBlueprint)
                     .addChild(rankOrAndNot->removeChild(0))
                     .addChild(std::move(_whiteListBlueprint));
@@ -10,6 +10,8 @@
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 
+namespace search::queryeval { class FilterResultCache; }
+
 namespace proton::matching {
 
 class ViewResolver;
@@ -23,6 +25,7 @@ private:
     Blueprint::UP           _blueprint;
     search::fef::Location   _location;
     Blueprint::UP           _whiteListBlueprint;
+    search::queryeval::FilterResultCache *_filterResultCache = nullptr;
 
 public:
     Query();
@@ -63,6 +66,14 @@ public:
      **/
     void setWhiteListBlueprint(Blueprint::UP whiteListBlueprint);
 
+    /**
+     * Serve the hits of filter subtrees of the query from the given
+     * cache. Must be called before reserveHandles.
+     *
+     * @param cache the filter result cache, may be nullptr
+     **/
+    void setFilterResultCache(search::queryeval::FilterResultCache *cache) { _filterResultCache = cache; }
+
     /**
      * Reserve room for terms in the query in the given match data
      * layout. This function also prepares the createSearch function
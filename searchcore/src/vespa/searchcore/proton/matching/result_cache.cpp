@@ -0,0 +1,212 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "result_cache.h"
+#include "isearchcontext.h"
+#include <vespa/searchcore/proton/documentmetastore/documentmetastoreattribute.h>
+#include <vespa/searchcommon/attribute/iattributecontext.h>
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+using search::MapNames;
+using search::attribute::IAttributeContext;
+using search::attribute::IAttributeVector;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+void append(vespalib::string &key, vespalib::stringref value) {
+    uint32_t size = value.size();
+    key.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    key.append(value.data(), value.size());
+}
+
+void append(vespalib::string &key, uint32_t value) {
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Collects all properties, to be sorted on key independent of insertion order
+struct PropertyCollector : IPropertiesVisitor {
+    std::vector<std::pair<vespalib::string, Property::Values>> props;
+    void visitProperty(const Property::Value &key, const Property &property) override {
+        Property::Values values;
+        for (uint32_t i = 0; i < property.size(); ++i) {
+            values.push_back(property.getAt(i));
+        }
+        props.emplace_back(key, std::move(values));
+    }
+};
+
+void append(vespalib::string &key, const Properties &properties) {
+    PropertyCollector collector;
+    properties.visitProperties(collector);
+    auto &props = collector.props;
+    std::sort(props.begin(), props.end(),
+              [](const auto &a, const auto &b) { return (a.first < b.first); });
+    append(key, uint32_t(props.size()));
+    for (const auto &prop: props) {
+        append(key, prop.first);
+        append(key, uint32_t(prop.second.size()));
+        for (const auto &value: prop.second) {
+            append(key, value);
+        }
+    }
+}
+
+// Properties used to control session caching or docsum generation do not affect the reply
+bool affectsReply(const vespalib::string &name) {
+    return ((name != MapNames::CACHES) && (name != MapNames::HIGHLIGHTTERMS));
+}
+
+uint64_t combine(uint64_t generation, uint64_t value) {
+    return (generation * 31) + value;
+}
+
+size_t calcMemoryUsed(const vespalib::string &key, const ResultCache::SearchReply &reply) {
+    return (key.size() + sizeof(ResultCache::SearchReply) +
+            (reply.hits.size() * sizeof(ResultCache::SearchReply::Hit)) +
+            (reply.sortIndex.size() * sizeof(uint32_t)) +
+            reply.sortData.size() + reply.groupResult.size() + reply.errorMessage.size());
+}
+
+} // namespace proton::matching::<unnamed>
+
+ResultCache::Entries::Entries(size_t maxEntries, size_t maxMemory)
+    : Lru(maxEntries),
+      _maxMemory(maxMemory),
+      _memoryUsed(0)
+{
+}
+
+ResultCache::Entries::~Entries() = default;
+
+bool
+ResultCache::Entries::removeOldest(const value_type &v)
+{
+    bool remove(Lru::removeOldest(v) || (_memoryUsed > _maxMemory));
+    if (remove) {
+        _memoryUsed -= v.second._value.memory_used;
+    }
+    return remove;
+}
+
+void
+ResultCache::Entries::onRemove(const vespalib::string &key)
+{
+    _memoryUsed -= get(key).memory_used;
+}
+
+void
+ResultCache::Entries::add(const vespalib::string &key, Entry entry)
+{
+    erase(key);
+    _memoryUsed += entry.memory_used;
+    insert(key, std::move(entry));
+}
+
+ResultCache::ResultCache(size_t maxEntries, size_t maxMemory)
+    : _lock(),
+      _entries(maxEntries, maxMemory)
+{
+}
+
+ResultCache::~ResultCache() = default;
+
+vespalib::string
+ResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::string key;
+    append(key, request.ranking);
+    append(key, request.getStackRef());
+    append(key, request.location);
+    append(key, request.sortSpec);
+    append(key, vespalib::stringref(request.groupSpec.data(), request.groupSpec.size()));
+    append(key, request.queryFlags);
+    append(key, request.offset);
+    append(key, request.maxhits);
+    std::vector<std::pair<vespalib::string, const Properties *>> maps;
+    for (const auto &entry: request.propertiesMap) {
+        if (affectsReply(entry.first)) {
+            maps.emplace_back(entry.first, &entry.second);
+        }
+    }
+    std::sort(maps.begin(), maps.end(),
+              [](const auto &a, const auto &b) { return (a.first < b.first); });
+    for (const auto &map: maps) {
+        append(key, map.first);
+        append(key, *map.second);
+    }
+    return key;
+}
+
+uint64_t
+ResultCache::getVisibilityGeneration(ISearchContext &searchContext, const IAttributeContext &attrContext)
+{
+    uint64_t generation = combine(searchContext.getIndexGeneration(), searchContext.getDocIdLimit());
+    std::vector<const IAttributeVector *> attributes;
+    attrContext.getAttributeList(attributes);
+    const IAttributeVector *metaStore = attrContext.getAttribute(DocumentMetaStoreAttribute::getFixedName());
+    if (metaStore != nullptr) {
+        attributes.push_back(metaStore);
+    }
+    for (const IAttributeVector *attribute: attributes) {
+        generation = combine(generation, attribute->getCommitGeneration());
+    }
+    return generation;
+}
+
+std::unique_ptr<ResultCache::SearchReply>
+ResultCache::lookup(const vespalib::string &key, uint64_t generation)
+{
+    std::shared_ptr<const SearchReply> reply;
+    {
+        LockGuard guard(_lock);
+        if (!_entries.hasKey(key)) {
+            return std::unique_ptr<SearchReply>();
+        }
+        const Entry &entry = _entries[key];
+        if (entry.generation != generation) {
+            _entries.erase(key);
+            return std::unique_ptr<SearchReply>();
+        }
+        reply = entry.reply;
+    }
+    return std::make_unique<SearchReply>(*reply);
+}
+
+void
+ResultCache::insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply)
+{
+    Entry entry;
+    entry.generation = generation;
+    entry.memory_used = calcMemoryUsed(key, reply);
+    if (entry.memory_used > _entries.maxMemory()) {
+        return;
+    }
+    entry.reply = std::make_shared<const SearchReply>(reply);
+    LockGuard guard(_lock);
+    _entries.add(key, std::move(entry));
+}
+
+size_t
+ResultCache::size() const
+{
+    LockGuard guard(_lock);
+    return _entries.size();
+}
+
+size_t
+ResultCache::memoryUsed() const
+{
+    LockGuard guard(_lock);
+    return _entries.memoryUsed();
+}
+
+}
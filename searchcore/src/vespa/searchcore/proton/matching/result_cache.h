@@ -0,0 +1,103 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/lrucache_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+
+namespace search::attribute { class IAttributeContext; }
+namespace search::engine {
+    class SearchRequest;
+    class SearchReply;
+}
+
+namespace proton::matching {
+
+class ISearchContext;
+
+/**
+ * Cache of complete search replies, used to answer repeated identical
+ * queries without matching them again. Each entry is keyed by all
+ * parts of the request that affect the reply and tagged with the
+ * visibility generation of the searched data when the reply was
+ * produced. Entries with another visibility generation are treated
+ * as misses and dropped. The least recently used entries are evicted
+ * when the cache holds too many entries or uses too much memory.
+ *
+ * This class is thread-safe.
+ **/
+class ResultCache
+{
+public:
+    using SearchRequest = search::engine::SearchRequest;
+    using SearchReply = search::engine::SearchReply;
+
+private:
+    using LockGuard = std::lock_guard<std::mutex>;
+
+    struct Entry {
+        uint64_t                           generation;
+        size_t                             memory_used;
+        std::shared_ptr<const SearchReply> reply;
+        Entry() : generation(0), memory_used(0), reply() {}
+    };
+
+    using LruParam = vespalib::LruParam<vespalib::string, Entry>;
+    using Lru = vespalib::lrucache_map<LruParam>;
+
+    class Entries : public Lru {
+    private:
+        using value_type = LruParam::value_type;
+        size_t _maxMemory;
+        size_t _memoryUsed;
+        bool removeOldest(const value_type &v) override;
+        void onRemove(const vespalib::string &key) override;
+    public:
+        Entries(size_t maxEntries, size_t maxMemory);
+        ~Entries() override;
+        void add(const vespalib::string &key, Entry entry);
+        size_t memoryUsed() const { return _memoryUsed; }
+        size_t maxMemory() const { return _maxMemory; }
+    };
+
+    mutable std::mutex _lock;
+    Entries            _entries;
+
+public:
+    ResultCache(size_t maxEntries, size_t maxMemory);
+    ~ResultCache();
+
+    /**
+     * Create a key identifying the reply to the given request.
+     * Session ids and cache properties are not part of the key.
+     **/
+    static vespalib::string makeKey(const SearchRequest &request);
+
+    /**
+     * Calculate the visibility generation of the searched data. It
+     * changes whenever a change to indexes, attributes or the
+     * document meta store is made visible to searches.
+     **/
+    static uint64_t getVisibilityGeneration(ISearchContext &searchContext,
+                                            const search::attribute::IAttributeContext &attrContext);
+
+    /**
+     * Look up a reply for the given key and visibility generation.
+     * Returns a copy of the cached reply, or an empty pointer if
+     * there is no valid entry.
+     **/
+    std::unique_ptr<SearchReply> lookup(const vespalib::string &key, uint64_t generation);
+
+    /**
+     * Store a copy of the given reply, replacing any older entry.
+     * Replies larger than the memory budget are not stored.
+     **/
+    void insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply);
+
+    size_t size() const;
+    size_t memoryUsed() const;
+};
+
+}
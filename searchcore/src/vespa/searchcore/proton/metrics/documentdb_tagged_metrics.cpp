@@ -60,7 +60,11 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::CacheMetrics::Cache
       elements("elements", {}, "Number of elements in the cache", this),
       hitRate("hit_rate", {}, "Rate of hits in the cache compared to number of lookups", this),
       lookups("lookups", {}, "Number of lookups in the cache (hits + misses)", this),
-      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache. ", this)
+      invalidations("invalidations", {}, "Number of invalidations (erased elements) in the cache. ", this),
+      evictions("evictions", {}, "Number of elements evicted from the cache to stay within its size limit", this),
+      maxShardMemoryUsage("max_shard_memory_usage", {},
+                          "Memory usage of the document cache shard using the most memory (in bytes). "
+                          "All shards have the same size limit, so this shows an uneven spread over the shards", this)
 {
 }
 
@@ -118,6 +122,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::update(const MatchingStats &stats)
     softDoomedQueries.inc(stats.softDoomed());
     softDoomFactor.set(stats.softDoomFactor());
     queries.inc(stats.queries());
+    resultCacheHits.inc(stats.resultCacheHits());
+    resultCacheMisses.inc(stats.resultCacheMisses());
     queryCollateralTime.addValueBatch(stats.queryCollateralTimeAvg(), stats.queryCollateralTimeCount(),
                                       stats.queryCollateralTimeMin(), stats.queryCollateralTimeMax());
     queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
@@ -131,6 +137,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
       queries("queries", {}, "Number of queries executed", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of queries looked up in the result cache without a match", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       queryCollateralTime("query_collateral_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
       queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
@@ -149,6 +157,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of queries looked up in the result cache without a match", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
       groupingTime("grouping_time", {}, "Average time (sec) spent on grouping", this),
       rerankTime("rerank_time", {}, "Average time (sec) spent on 2nd phase ranking", this),
@@ -195,6 +205,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
     softDoomedQueries.inc(stats.softDoomed());
+    resultCacheHits.inc(stats.resultCacheHits());
+    resultCacheMisses.inc(stats.resultCacheMisses());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
                             stats.matchTimeMin(), stats.matchTimeMax());
     groupingTime.addValueBatch(stats.groupingTimeAvg(), stats.groupingTimeCount(),
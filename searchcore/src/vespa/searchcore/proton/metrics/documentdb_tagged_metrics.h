@@ -57,6 +57,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongAverageMetric hitRate;
                 metrics::LongCountMetric lookups;
                 metrics::LongCountMetric invalidations;
+                metrics::LongCountMetric evictions;
+                metrics::LongValueMetric maxShardMemoryUsage;
 
                 CacheMetrics(metrics::MetricSet *parent);
                 ~CacheMetrics();
@@ -115,6 +117,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         metrics::LongCountMetric docsReRanked;
         metrics::LongCountMetric queries;
         metrics::LongCountMetric softDoomedQueries;
+        metrics::LongCountMetric resultCacheHits;
+        metrics::LongCountMetric resultCacheMisses;
         metrics::DoubleValueMetric softDoomFactor;
         metrics::DoubleAverageMetric queryCollateralTime;
         metrics::DoubleAverageMetric queryLatency;
@@ -141,6 +145,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
             metrics::LongCountMetric     softDoomedQueries;
+            metrics::LongCountMetric     resultCacheHits;
+            metrics::LongCountMetric     resultCacheMisses;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
             metrics::DoubleAverageMetric rerankTime;
@@ -256,7 +256,13 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreM
     updateDocumentStoreCacheHitRate(cacheStats, lastCacheStats, metrics.cache.hitRate);
     updateCountMetric(cacheStats.lookups(), lastCacheStats.lookups(), metrics.cache.lookups);
     updateCountMetric(cacheStats.invalidations, lastCacheStats.invalidations, metrics.cache.invalidations);
+    updateCountMetric(cacheStats.evictions, lastCacheStats.evictions, metrics.cache.evictions);
     lastCacheStats = cacheStats;
+    size_t maxShardMemoryUsage = 0;
+    for (const search::CacheStats &shardStats : backingStore.getCacheShardStats()) {
+        maxShardMemoryUsage = std::max(maxShardMemoryUsage, shardStats.memory_used);
+    }
+    metrics.cache.maxShardMemoryUsage.set(maxShardMemoryUsage);
 }
 
 void
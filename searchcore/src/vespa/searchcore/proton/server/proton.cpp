@@ -24,11 +24,13 @@
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/util/fileheadertk.h>
+#include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
+#include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/host_name.h>
 #include <vespa/vespalib/util/random.h>
@@ -78,6 +80,20 @@ setFS4Compression(const ProtonConfig & proton)
     fs4.SetCompressionType(convert(proton.packetcompresstype));
 }
 
+void
+setupObjectCache(const vespalib::string &dir, size_t maxSize)
+{
+    if (dir.empty()) {
+        return;
+    }
+    try {
+        vespalib::mkdir(dir, true);
+        vespalib::eval::CompileCache::set_object_cache_dir(dir, maxSize);
+    } catch (const vespalib::IoException &e) {
+        LOG(warning, "Could not use '%s' as object cache for ranking expressions: %s", dir.c_str(), e.what());
+    }
+}
+
 DiskMemUsageSampler::Config
 diskMemUsageSamplerConfig(const ProtonConfig &proton, const HwInfo &hwInfo)
 {
@@ -273,6 +289,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     }
     _protonDiskLayout = std::make_unique<ProtonDiskLayout>(protonConfig.basedir, protonConfig.tlsspec);
     vespalib::chdir(protonConfig.basedir);
+    setupObjectCache(protonConfig.ranking.objectcache.dir, protonConfig.ranking.objectcache.maxsize);
     _tls->start();
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, flush.idleinterval*1000);
@@ -3,6 +3,7 @@
 #include "searchcontext.h"
 
 using search::queryeval::Searchable;
+using searchcorespi::IndexSearchable;
 
 namespace proton {
 
@@ -23,7 +24,12 @@ uint32_t SearchContext::getDocIdLimit()
     return _docIdLimit;
 }
 
-SearchContext::SearchContext(const Searchable::SP &indexSearchable, uint32_t docIdLimit)
+uint64_t SearchContext::getIndexGeneration()
+{
+    return _indexSearchable->getSerialNum();
+}
+
+SearchContext::SearchContext(const IndexSearchable::SP &indexSearchable, uint32_t docIdLimit)
     : _indexSearchable(indexSearchable),
       _attributeBlueprintFactory(),
       _docIdLimit(docIdLimit)
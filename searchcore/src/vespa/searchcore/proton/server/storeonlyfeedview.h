@@ -66,6 +66,7 @@ public:
     using PromisedDoc = std::promise<std::unique_ptr<const Document>>;
     using FutureStream = std::future<vespalib::nbostream>;
     using PromisedStream = std::promise<vespalib::nbostream>;
+    using SerializedDocumentSP = std::shared_ptr<const vespalib::nbostream>;
     using DocumentSP = std::shared_ptr<Document>;
     using DocumentUpdateSP = std::shared_ptr<DocumentUpdate>;
 
@@ -160,6 +161,7 @@ private:
     }
     void putSummary(SerialNum serialNum,  Lid lid, FutureStream doc, OnOperationDoneType onDone);
     void putSummary(SerialNum serialNum,  Lid lid, DocumentSP doc, OnOperationDoneType onDone);
+    void putSummary(SerialNum serialNum,  Lid lid, SerializedDocumentSP doc, OnOperationDoneType onDone);
     void removeSummary(SerialNum serialNum,  Lid lid, OnWriteDoneType onDone);
     void heartBeatSummary(SerialNum serialNum);
 
@@ -46,6 +46,9 @@ struct DocumentMetaStoreObserver : public IDocumentMetaStore
     virtual search::LidUsageStats getLidUsageStats() const override {
         return _store.getLidUsageStats();
     }
+    bool isLidSpaceInFeedOrder() const override {
+        return _store.isLidSpaceInFeedOrder();
+    }
     virtual search::queryeval::Blueprint::UP createWhiteListBlueprint() const override {
         return _store.createWhiteListBlueprint();
     }
@@ -37,6 +37,7 @@ struct DummyDocumentStore : public search::IDocumentStore
     virtual size_t getDiskBloat() const override { return 0; }
     virtual size_t getMaxCompactGain() const override { return getDiskBloat(); }
     virtual search::CacheStats getCacheStats() const override { return search::CacheStats(); }
+    virtual std::vector<search::CacheStats> getCacheShardStats() const override { return {}; }
     virtual const vespalib::string &getBaseDir() const override { return _baseDir; }
     virtual void accept(search::IDocumentStoreReadVisitor &,
                         search::IDocumentStoreVisitorProgress &,
@@ -3,8 +3,13 @@
 #include <vespa/searchlib/docstore/logdocumentstore.h>
 #include <vespa/searchlib/docstore/value.h>
 #include <vespa/searchlib/docstore/cachestats.h>
+#include <vespa/searchlib/docstore/visitcache.h>
+#include <vespa/searchlib/docstore/ibucketizer.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <map>
 
 using namespace search;
 using CompressionConfig = vespalib::compression::CompressionConfig;
@@ -63,6 +68,145 @@ TEST_FFF("require that cached docstore lookups are counted",
     EXPECT_EQUAL(1u, f3.getCacheStats().misses);
 }
 
+struct MemoryDataStore : NullDataStore {
+    std::map<uint32_t, std::vector<char>> _docs;
+    mutable size_t _reads;
+    mutable size_t _visits;
+    MemoryDataStore() : NullDataStore(), _docs(), _reads(0), _visits(0) {}
+    ssize_t read(uint32_t lid, vespalib::DataBuffer &buf) const override {
+        ++_reads;
+        auto found = _docs.find(lid);
+        if (found == _docs.end()) {
+            return 0;
+        }
+        buf.writeBytes(found->second.data(), found->second.size());
+        return found->second.size();
+    }
+    void read(const LidVector &lids, IBufferVisitor &visitor) const override {
+        ++_visits;
+        for (uint32_t lid : lids) {
+            auto found = _docs.find(lid);
+            if (found != _docs.end()) {
+                visitor.visit(lid, vespalib::ConstBufferRef(found->second.data(), found->second.size()));
+            }
+        }
+    }
+    void write(uint64_t, uint32_t lid, const void *buf, size_t sz) override {
+        const char *data = static_cast<const char *>(buf);
+        _docs[lid].assign(data, data + sz);
+    }
+};
+
+// Number of shards in the document cache; lids that are multiples of this share the first shard.
+const uint32_t NUM_SHARDS = 16;
+
+// Fixed width ids give all documents the same size in the cache.
+document::Document makeDoc(uint32_t lid) {
+    return document::Document(*repo.getDocumentType("document"),
+                              document::DocumentId(vespalib::make_string("id:ns:document::%06u", lid)));
+}
+
+struct CacheFixture {
+    MemoryDataStore backing;
+    DocumentStore store;
+    CacheFixture(size_t maxCacheBytes)
+        : backing(),
+          store(DocumentStore::Config(CompressionConfig::NONE, maxCacheBytes, 0), backing)
+    {}
+    void put(uint32_t lid) { store.write(1, lid, makeDoc(lid)); }
+    bool read(uint32_t lid) {
+        auto doc = store.read(lid, repo);
+        return doc && (doc->getId() == makeDoc(lid).getId());
+    }
+};
+
+size_t cacheEntryBytes() {
+    CacheFixture f(1000000);
+    f.put(1);
+    f.read(1);
+    return f.store.getCacheShardStats()[1].memory_used;
+}
+
+TEST_F("require that document cache is split in shards by lid", CacheFixture(1000000)) {
+    for (uint32_t lid(1); lid <= 2 * NUM_SHARDS; lid++) {
+        f.put(lid);
+        EXPECT_TRUE(f.read(lid));
+    }
+    std::vector<CacheStats> shards = f.store.getCacheShardStats();
+    ASSERT_EQUAL(NUM_SHARDS, shards.size());
+    for (const CacheStats & shard : shards) {
+        EXPECT_EQUAL(2u, shard.elements);
+        EXPECT_EQUAL(2u, shard.misses);
+        EXPECT_EQUAL(0u, shard.evictions);
+    }
+    EXPECT_TRUE(f.read(NUM_SHARDS));
+    shards = f.store.getCacheShardStats();
+    EXPECT_EQUAL(1u, shards[0].hits);
+    EXPECT_EQUAL(0u, shards[1].hits);
+    CacheStats total = f.store.getCacheStats();
+    EXPECT_EQUAL(2 * NUM_SHARDS, total.elements);
+    EXPECT_EQUAL(1u, total.hits);
+}
+
+TEST_F("require that documents read more than once are protected from evictions by one-off reads",
+       CacheFixture(NUM_SHARDS * 4 * cacheEntryBytes()))
+{
+    const uint32_t hot = NUM_SHARDS;
+    const uint32_t cold = 2 * NUM_SHARDS;
+    const uint32_t numScanned = 20;
+    for (uint32_t i(1); i <= numScanned + 2; i++) {
+        f.put(i * NUM_SHARDS);
+    }
+    EXPECT_TRUE(f.read(hot));
+    EXPECT_TRUE(f.read(hot));
+    EXPECT_TRUE(f.read(cold));
+    for (uint32_t i(3); i <= numScanned + 2; i++) {
+        EXPECT_TRUE(f.read(i * NUM_SHARDS));
+    }
+    size_t readsBefore = f.backing._reads;
+    EXPECT_TRUE(f.read(hot));
+    EXPECT_EQUAL(readsBefore, f.backing._reads);
+
+    CacheStats shard = f.store.getCacheShardStats()[0];
+    EXPECT_EQUAL(2u, shard.hits);
+    EXPECT_EQUAL(numScanned + 2, shard.misses);
+    EXPECT_LESS(shard.elements, numScanned);
+    EXPECT_EQUAL(numScanned + 2 - shard.elements, shard.evictions);
+    EXPECT_EQUAL(shard.evictions, f.store.getCacheStats().evictions);
+
+    EXPECT_TRUE(f.read(cold));
+    EXPECT_EQUAL(readsBefore + 1, f.backing._reads);
+}
+
+TEST("require that sets visited more than once survive a full visit and are still invalidated") {
+    using docstore::VisitCache;
+    MemoryDataStore backing;
+    for (uint32_t lid(1); lid <= 40; lid++) {
+        backing.write(1, lid, "0123456789", 10);
+    }
+    size_t entryBytes;
+    {
+        VisitCache probe(backing, 1000000, CompressionConfig::NONE);
+        probe.read({1, 2});
+        entryBytes = probe.getCacheStats().memory_used;
+    }
+    VisitCache cache(backing, 4 * entryBytes, CompressionConfig::NONE);
+    const IDocumentStore::LidVector hot({1, 2});
+    cache.read(hot);
+    cache.read(hot);
+    for (uint32_t lid(3); lid < 40; lid += 2) {
+        cache.read({lid, lid + 1});
+    }
+    EXPECT_GREATER(cache.getCacheStats().evictions, 0u);
+    size_t visitsBefore = backing._visits;
+    EXPECT_EQUAL(2u, cache.read(hot).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(visitsBefore, backing._visits);
+
+    cache.remove(1);
+    EXPECT_EQUAL(2u, cache.read(hot).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(visitsBefore + 1, backing._visits);
+}
+
 TEST("require that DocumentStore::Config equality operator detects inequality") {
     using C = DocumentStore::Config;
     EXPECT_TRUE(C() == C());
@@ -15,6 +15,7 @@
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
 #include <iomanip>
 
 using document::BucketId;
@@ -660,6 +661,29 @@ TEST("test that the integrated visit cache works.") {
     TEST_DO(verifyCacheStats(ds.getCacheStats(), 101, 108, 99, BASE_SZ+340));
 }
 
+TEST("require that visiting many lids per chunk returns the latest version of each document") {
+    VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INVALIDATE);
+    std::vector<uint32_t> lids;
+    for (uint32_t i(1); i <= 100; i++) {
+        vcs.write(i);
+        lids.push_back(i);
+    }
+    for (uint32_t i(1); i <= 100; i += 7) {
+        vcs.rewrite(i);
+    }
+    vcs.remove(50);
+    vcs.recreate();
+    std::vector<uint32_t> expected;
+    for (uint32_t lid : lids) {
+        if (lid != 50) {
+            expected.push_back(lid);
+        }
+    }
+    vcs.verifyVisit(lids, expected, false);
+    std::reverse(lids.begin(), lids.end());
+    vcs.verifyVisit(lids, expected, false);
+}
+
 TEST("testWriteRead") {
     FastOS_File::RemoveDirectory("empty");
     const char * bufA = "aaaaaaaaaaaaaaaaaaaaa";
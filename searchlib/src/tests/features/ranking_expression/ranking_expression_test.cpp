@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 
 #include <vespa/eval/eval/value_type.h>
+#include <vespa/searchlib/fef/batch_feature_executor.h>
 #include <vespa/searchlib/fef/feature_type.h>
 #include <vespa/searchlib/fef/featurenameparser.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
@@ -161,4 +162,28 @@ TEST_F("require that replaced expressions create the appropriate executor", Setu
     EXPECT_TRUE(dynamic_cast<DummyExecutor*>(&executor) != nullptr);
 }
 
+TEST_F("require that compiled expressions can be evaluated for a batch of documents", SetupResult({}, "a*b")) {
+    EXPECT_TRUE(f1.setup_ok);
+    auto *executor = dynamic_cast<BatchFeatureExecutor*>(&f1.rank.createExecutor(f1.query_env, f1.stash));
+    ASSERT_TRUE(executor != nullptr);
+    NumberOrObject a;
+    NumberOrObject b;
+    a.as_number = 2.0;
+    b.as_number = 3.0;
+    std::vector<LazyValue> inputs({LazyValue(&a), LazyValue(&b)});
+    executor->bind_inputs(inputs);
+    ASSERT_EQUAL(2u, executor->num_batch_inputs());
+    std::vector<double> params(6, 0.0);
+    executor->gather_batch_inputs(1, &params[0]);
+    a.as_number = 4.0;
+    executor->gather_batch_inputs(2, &params[2]);
+    b.as_number = 5.0;
+    executor->gather_batch_inputs(3, &params[4]);
+    std::vector<double> results(3, 0.0);
+    executor->execute_batch(&params[0], 3, &results[0]);
+    EXPECT_EQUAL(6.0, results[0]);
+    EXPECT_EQUAL(12.0, results[1]);
+    EXPECT_EQUAL(20.0, results[2]);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
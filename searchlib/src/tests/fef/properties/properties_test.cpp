@@ -295,6 +295,38 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        { // vespa.matching.filter_cache_max_memory
+            EXPECT_EQUAL(matching::FilterCacheMaxMemory::NAME, vespalib::string("vespa.matching.filter_cache_max_memory"));
+            EXPECT_EQUAL(matching::FilterCacheMaxMemory::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::FilterCacheMaxMemory::lookup(p), 0u);
+            p.add("vespa.matching.filter_cache_max_memory", "1000000");
+            EXPECT_EQUAL(matching::FilterCacheMaxMemory::lookup(p), 1000000u);
+        }
+        { // vespa.matching.result_cache_size
+            EXPECT_EQUAL(matching::ResultCacheSize::NAME, vespalib::string("vespa.matching.result_cache_size"));
+            EXPECT_EQUAL(matching::ResultCacheSize::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheSize::lookup(p), 0u);
+            p.add("vespa.matching.result_cache_size", "1000");
+            EXPECT_EQUAL(matching::ResultCacheSize::lookup(p), 1000u);
+        }
+        { // vespa.matching.result_cache_max_memory
+            EXPECT_EQUAL(matching::ResultCacheMaxMemory::NAME, vespalib::string("vespa.matching.result_cache_max_memory"));
+            EXPECT_EQUAL(matching::ResultCacheMaxMemory::DEFAULT_VALUE, 16u * 1024u * 1024u);
+            Properties p;
+            EXPECT_EQUAL(matching::ResultCacheMaxMemory::lookup(p), 16u * 1024u * 1024u);
+            p.add("vespa.matching.result_cache_max_memory", "1000000");
+            EXPECT_EQUAL(matching::ResultCacheMaxMemory::lookup(p), 1000000u);
+        }
+        { // vespa.matching.static_rank_order_hits
+            EXPECT_EQUAL(matching::StaticRankOrderHits::NAME, vespalib::string("vespa.matching.static_rank_order_hits"));
+            EXPECT_EQUAL(matching::StaticRankOrderHits::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::StaticRankOrderHits::lookup(p), 0u);
+            p.add("vespa.matching.static_rank_order_hits", "500");
+            EXPECT_EQUAL(matching::StaticRankOrderHits::lookup(p), 500u);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -403,6 +435,22 @@ TEST("test stuff") {
             p.clear().add("vespa.hitcollector.rankscoredroplimit", "123456789.12345");
             EXPECT_EQUAL(hitcollector::RankScoreDropLimit::lookup(p), 123456789.12345);
         }
+        { // vespa.hitcollector.diversity.attribute
+            EXPECT_EQUAL(hitcollector::DiversityAttribute::NAME, vespalib::string("vespa.hitcollector.diversity.attribute"));
+            EXPECT_EQUAL(hitcollector::DiversityAttribute::DEFAULT_VALUE, "");
+            Properties p;
+            EXPECT_EQUAL(hitcollector::DiversityAttribute::lookup(p), "");
+            p.add("vespa.hitcollector.diversity.attribute", "foobar");
+            EXPECT_EQUAL(hitcollector::DiversityAttribute::lookup(p), "foobar");
+        }
+        { // vespa.hitcollector.diversity.maxhitspergroup
+            EXPECT_EQUAL(hitcollector::DiversityMaxHitsPerGroup::NAME, vespalib::string("vespa.hitcollector.diversity.maxhitspergroup"));
+            EXPECT_EQUAL(hitcollector::DiversityMaxHitsPerGroup::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(hitcollector::DiversityMaxHitsPerGroup::lookup(p), 0u);
+            p.add("vespa.hitcollector.diversity.maxhitspergroup", "3");
+            EXPECT_EQUAL(hitcollector::DiversityMaxHitsPerGroup::lookup(p), 3u);
+        }
         { // vespa.fieldweight.
             EXPECT_EQUAL(FieldWeight::BASE_NAME, vespalib::string("vespa.fieldweight."));
             EXPECT_EQUAL(FieldWeight::DEFAULT_VALUE, 100u);
@@ -148,6 +148,7 @@ public:
     void testAggregationSimple();
     void testAggregationLevels();
     void testAggregationMaxGroups();
+    void testAggregationManyGroups();
     void testAggregationGroupOrder();
     void testAggregationGroupRank();
     void testAggregationGroupCapping();
@@ -543,6 +544,40 @@ Test::testAggregationMaxGroups()
     }
 }
 
+/**
+ * Verify that group ids and aggregation state survive the backing
+ * storage growing while many groups are created.
+ **/
+void
+Test::testAggregationManyGroups()
+{
+    const int64_t numGroups = 1000;
+    AggregationContext ctx;
+    IntAttrBuilder keys("key");
+    IntAttrBuilder values("value");
+    for (int64_t docId = 0; docId < 2 * numGroups; ++docId) {
+        keys.add(docId % numGroups);
+        values.add(docId);
+        ctx.result().add(docId);
+    }
+    ctx.add(keys.sp());
+    ctx.add(values.sp());
+
+    Grouping request = Grouping()
+                       .setRoot(Group().setId(NullResultNode()))
+                       .addLevel(createGL(MU<AttributeNode>("key"), MU<AttributeNode>("value")));
+
+    Group expect;
+    expect.setId(NullResultNode());
+    for (int64_t key = 0; key < numGroups; ++key) {
+        expect.addChild(Group().setId(Int64ResultNode(key))
+                               .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("value"))
+                                                                .setResult(Int64ResultNode(2 * key + numGroups))));
+    }
+
+    EXPECT_TRUE(testAggregation(ctx, request, expect));
+}
+
 /**
  * Verify that groups are sorted by group id
  **/
@@ -1953,6 +1988,7 @@ Test::Main()
     testAggregationSimple();
     testAggregationLevels();
     testAggregationMaxGroups();
+    testAggregationManyGroups();
     testAggregationGroupOrder();
     testAggregationGroupRank();
     testAggregationGroupCapping();
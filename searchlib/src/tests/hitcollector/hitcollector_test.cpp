@@ -37,6 +37,22 @@ struct PredefinedScorer : public HitCollector::DocumentScorer
     }
 };
 
+struct BatchScorer : public HitCollector::DocumentScorer
+{
+    std::vector<std::vector<uint32_t>> _batches;
+    feature_t score(uint32_t) override {
+        ASSERT_TRUE(false); // all hits should be scored in batch
+        return 0.0;
+    }
+    void scoreHits(std::vector<HitCollector::Hit> &hits) override {
+        _batches.emplace_back();
+        for (auto &hit : hits) {
+            _batches.back().push_back(hit.first);
+            hit.second = hit.first + 300;
+        }
+    }
+};
+
 std::vector<HitCollector::Hit> extract(SortedHitSequence seq) {
     std::vector<HitCollector::Hit> ret;
     while (seq.valid()) {
@@ -248,6 +264,22 @@ TEST_F("require that hits for 2nd phase candidates can be retrieved", Descending
     EXPECT_EQUAL(96, scores[4].second);
 }
 
+TEST("require that all hits to re-rank are scored together in docid order") {
+    HitCollector hc(20, 10);
+    for (uint32_t i = 0; i < 20; ++i) {
+        hc.addHit(i, 100 - i);
+    }
+    BatchScorer scorer;
+    EXPECT_EQUAL(5u, hc.reRank(scorer, extract(hc.getSortedHitSequence(5))));
+    ASSERT_EQUAL(1u, scorer._batches.size());
+    ASSERT_EQUAL(5u, scorer._batches[0].size());
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_EQUAL(i, scorer._batches[0][i]);
+    }
+    EXPECT_EQUAL(300.0, hc.getRanges().second.low);
+    EXPECT_EQUAL(304.0, hc.getRanges().second.high);
+}
+
 TEST("require that score ranges can be read and set.") {
     std::pair<Scores, Scores> ranges = std::make_pair(Scores(1.0, 2.0), Scores(3.0, 4.0));
     HitCollector hc(20, 10);
@@ -527,4 +559,63 @@ TEST("require that hits can be added out of order only after passing array limit
     TEST_DO(checkResult(*rs, nullptr));
 }
 
+struct RangeGrouper : public HitCollector::DocumentGrouper
+{
+    uint32_t _groupSize;
+    explicit RangeGrouper(uint32_t groupSize) : _groupSize(groupSize) {}
+    uint64_t group(uint32_t docId) override { return docId / _groupSize; }
+};
+
+TEST("require that ranked hits are limited per group") {
+    HitCollector hc(30, 6, std::make_unique<RangeGrouper>(10), 2);
+    BitVector::UP expBv(BitVector::create(30));
+    for (uint32_t i = 0; i < 30; ++i) {
+        hc.addHit(i, i + 100);
+        expBv->setBit(i);
+    }
+    std::vector<RankedHit> expRh;
+    for (uint32_t docId : {8, 9, 18, 19, 28, 29}) {
+        expRh.push_back(RankedHit(docId, docId + 100));
+    }
+    std::unique_ptr<ResultSet> rs = hc.getResultSet();
+    TEST_DO(checkResult(*rs, expRh));
+    TEST_DO(checkResult(*rs, expBv.get()));
+}
+
+TEST("require that the best hits are kept when limited per group") {
+    std::vector<HitCollector::Hit> all;
+    for (uint32_t i = 0; i < 400; ++i) {
+        all.emplace_back(i, (i * 7919) % 401);
+    }
+    std::vector<HitCollector::Hit> capped;
+    std::map<uint32_t, uint32_t> groupCount;
+    std::vector<HitCollector::Hit> sorted(all);
+    std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return (a.second > b.second); });
+    for (const auto &hit : sorted) {
+        if ((++groupCount[hit.first / 100] <= 3) && (capped.size() < 7)) {
+            capped.push_back(hit);
+        }
+    }
+    HitCollector hc(400, 7, std::make_unique<RangeGrouper>(100), 3);
+    for (const auto &hit : all) {
+        hc.addHit(hit.first, hit.second);
+    }
+    EXPECT_TRUE(extract(hc.getSortedHitSequence(10)) == capped);
+    std::unique_ptr<ResultSet> rs = hc.getResultSet();
+    EXPECT_EQUAL(7u, rs->getArrayUsed());
+}
+
+TEST("require that a missing document grouper gives regular hit collection") {
+    HitCollector hc(30, 6, std::unique_ptr<HitCollector::DocumentGrouper>(), 2);
+    for (uint32_t i = 0; i < 30; ++i) {
+        hc.addHit(i, i + 100);
+    }
+    std::vector<RankedHit> expRh;
+    for (uint32_t docId = 24; docId < 30; ++docId) {
+        expRh.push_back(RankedHit(docId, docId + 100));
+    }
+    std::unique_ptr<ResultSet> rs = hc.getResultSet();
+    TEST_DO(checkResult(*rs, expRh));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
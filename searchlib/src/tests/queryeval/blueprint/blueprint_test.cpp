@@ -672,6 +672,8 @@ getExpectedBlueprint()
            "        estHits: 9\n"
            "        tree_size: 2\n"
            "        allow_termwise_eval: 0\n"
+           "        cost: 1\n"
+           "        strict_cost: 1\n"
            "    }\n"
            "    sourceId: 4294967295\n"
            "    docid_limit: 0\n"
@@ -690,6 +692,8 @@ getExpectedBlueprint()
            "                estHits: 9\n"
            "                tree_size: 1\n"
            "                allow_termwise_eval: 1\n"
+           "                cost: 1\n"
+           "                strict_cost: 1\n"
            "            }\n"
            "            sourceId: 4294967295\n"
            "            docid_limit: 0\n"
@@ -135,6 +135,65 @@ TEST("test And Blueprint") {
     // createSearch tested by iterator unit test
 }
 
+std::vector<Blueprint *> sort_and_children(const std::vector<Blueprint *> &input, uint32_t docid_limit) {
+    AndBlueprint b;
+    b.setDocIdLimit(docid_limit);
+    std::vector<Blueprint *> children(input);
+    for (Blueprint *child: children) {
+        child->setDocIdLimit(docid_limit);
+    }
+    b.sort(children);
+    return children;
+}
+
+TEST("require that And Blueprint keeps estimate order when all children have the same cost") {
+    Blueprint::UP c1 = ap(MyLeafSpec(200).create());
+    Blueprint::UP c2 = ap(MyLeafSpec(400).create());
+    Blueprint::UP c3 = ap(MyLeafSpec(100).create());
+    Blueprint::UP c4 = ap(MyLeafSpec(300).create());
+    auto children = sort_and_children({c1.get(), c2.get(), c3.get(), c4.get()}, 1000);
+    ASSERT_EQUAL(4u, children.size());
+    EXPECT_EQUAL(c3.get(), children[0]);
+    EXPECT_EQUAL(c1.get(), children[1]);
+    EXPECT_EQUAL(c4.get(), children[2]);
+    EXPECT_EQUAL(c2.get(), children[3]);
+}
+
+TEST("require that And Blueprint checks expensive children last") {
+    Blueprint::UP c1 = ap(MyLeafSpec(100).cost(10.0).create());
+    Blueprint::UP c2 = ap(MyLeafSpec(200).create());
+    Blueprint::UP c3 = ap(MyLeafSpec(400).create());
+    auto children = sort_and_children({c1.get(), c2.get(), c3.get()}, 1000);
+    ASSERT_EQUAL(3u, children.size());
+    EXPECT_EQUAL(c2.get(), children[0]);
+    EXPECT_EQUAL(c3.get(), children[1]);
+    EXPECT_EQUAL(c1.get(), children[2]);
+}
+
+TEST("require that And Blueprint does not make a scanning child strict") {
+    Blueprint::UP c1 = ap(MyLeafSpec(10).strict_scan().create());
+    Blueprint::UP c2 = ap(MyLeafSpec(100).create());
+    Blueprint::UP c3 = ap(MyLeafSpec(200).create());
+    auto children = sort_and_children({c1.get(), c2.get(), c3.get()}, 1000);
+    ASSERT_EQUAL(3u, children.size());
+    EXPECT_EQUAL(c2.get(), children[0]);
+    EXPECT_EQUAL(c1.get(), children[1]);
+    EXPECT_EQUAL(c3.get(), children[2]);
+}
+
+TEST("require that And Blueprint cost depends on child order") {
+    AndBlueprint b;
+    b.addChild(ap(MyLeafSpec(100).create()));
+    b.addChild(ap(MyLeafSpec(500).create()));
+    b.setDocIdLimit(1000);
+    EXPECT_APPROX(1.1, b.cost(), 1e-9);
+    EXPECT_APPROX(0.2, b.strict_cost(), 1e-9);
+    Blueprint::UP first = b.removeChild(0);
+    b.addChild(std::move(first));
+    EXPECT_APPROX(1.5, b.cost(), 1e-9);
+    EXPECT_APPROX(1.0, b.strict_cost(), 1e-9);
+}
+
 TEST("test Or Blueprint") {
     OrBlueprint b;
     { // combine
@@ -124,6 +124,12 @@ public:
         setEstimate(HitEstimate(hits, empty));
         return *this;
     }
+
+    MyLeaf &cost_model(double cost_in, bool strict_scan_in) {
+        set_cost(cost_in);
+        set_strict_scan(strict_scan_in);
+        return *this;
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -133,18 +139,29 @@ class MyLeafSpec
 private:
     FieldSpecBaseList      _fields;
     Blueprint::HitEstimate _estimate;
+    double                 _cost;
+    bool                   _strict_scan;
 
 public:
     explicit MyLeafSpec(uint32_t estHits, bool empty = false)
-        : _fields(), _estimate(estHits, empty) {}
+        : _fields(), _estimate(estHits, empty), _cost(1.0), _strict_scan(false) {}
 
     MyLeafSpec &addField(uint32_t fieldId, uint32_t handle) {
         _fields.add(FieldSpecBase(fieldId, handle));
         return *this;
     }
+    MyLeafSpec &cost(double value) {
+        _cost = value;
+        return *this;
+    }
+    MyLeafSpec &strict_scan() {
+        _strict_scan = true;
+        return *this;
+    }
     MyLeaf *create() const {
         MyLeaf *leaf = new MyLeaf(_fields);
         leaf->estimate(_estimate.estHits, _estimate.empty);
+        leaf->cost_model(_cost, _strict_scan);
         return leaf;
     }
 };
@@ -0,0 +1,167 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/queryeval/filter_result_cache.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/queryeval/simpleresult.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/matchdata.h>
+
+using namespace search;
+using namespace search::fef;
+using namespace search::queryeval;
+
+using BitVectorSP = FilterResultCache::BitVectorSP;
+
+const uint32_t docid_limit = 100;
+
+BitVectorSP make_hits(std::initializer_list<uint32_t> docs, uint32_t limit = docid_limit) {
+    std::shared_ptr<BitVector> bv(BitVector::create(limit).release());
+    for (uint32_t docid: docs) {
+        bv->setBit(docid);
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+size_t entry_size(const vespalib::string &key, const BitVector &bv) {
+    return (key.size() + bv.getFileBytes());
+}
+
+SimpleResult collect(SearchIterator &search, bool strict) {
+    SimpleResult result;
+    if (strict) {
+        result.searchStrict(search, docid_limit);
+    } else {
+        result.search(search, docid_limit);
+    }
+    return result;
+}
+
+Blueprint::UP make_and_blueprint(std::initializer_list<uint32_t> a, std::initializer_list<uint32_t> b) {
+    FieldSpec field("foo", 1, 0);
+    FakeResult res_a;
+    for (uint32_t docid: a) {
+        res_a.doc(docid);
+    }
+    FakeResult res_b;
+    for (uint32_t docid: b) {
+        res_b.doc(docid);
+    }
+    auto blueprint = std::make_unique<AndBlueprint>();
+    blueprint->addChild(std::make_unique<FakeBlueprint>(field, res_a));
+    blueprint->addChild(std::make_unique<FakeBlueprint>(field, res_b));
+    return blueprint;
+}
+
+MatchData::UP make_filter_match_data() {
+    MatchData::UP md = MatchData::makeTestInstance(1, 2);
+    md->resolveTermField(0)->tagAsNotNeeded();
+    return md;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST("require that inserted results can be looked up") {
+    FilterResultCache cache(1000000);
+    EXPECT_TRUE(!cache.lookup("a", 5, docid_limit));
+    auto hits = make_hits({3, 7});
+    cache.insert("a", 5, hits);
+    EXPECT_EQUAL(hits.get(), cache.lookup("a", 5, docid_limit).get());
+    EXPECT_TRUE(!cache.lookup("b", 5, docid_limit));
+    auto stats = cache.get_stats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(2u, stats.misses);
+    EXPECT_EQUAL(1u, stats.entries);
+    EXPECT_EQUAL(entry_size("a", *hits), stats.memory_used);
+}
+
+TEST("require that results for other generations or docid limits are not used") {
+    FilterResultCache cache(1000000);
+    cache.insert("a", 5, make_hits({3, 7}));
+    EXPECT_TRUE(!cache.lookup("a", 5, docid_limit + 1));
+    EXPECT_TRUE(!cache.lookup("a", 5, docid_limit));
+    cache.insert("a", 5, make_hits({3, 7}));
+    EXPECT_TRUE(!cache.lookup("a", 6, docid_limit));
+    auto stats = cache.get_stats();
+    EXPECT_EQUAL(0u, stats.hits);
+    EXPECT_EQUAL(3u, stats.misses);
+    EXPECT_EQUAL(0u, stats.entries);
+    EXPECT_EQUAL(0u, stats.memory_used);
+}
+
+TEST("require that least recently used results are evicted to stay within memory budget") {
+    auto hits = make_hits({});
+    FilterResultCache cache(2 * entry_size("a", *hits));
+    cache.insert("a", 1, make_hits({1}));
+    cache.insert("b", 1, make_hits({2}));
+    EXPECT_TRUE(cache.lookup("a", 1, docid_limit));
+    cache.insert("c", 1, make_hits({3}));
+    EXPECT_TRUE(cache.lookup("a", 1, docid_limit));
+    EXPECT_TRUE(!cache.lookup("b", 1, docid_limit));
+    EXPECT_TRUE(cache.lookup("c", 1, docid_limit));
+    EXPECT_EQUAL(2u, cache.get_stats().entries);
+    EXPECT_EQUAL(cache.max_memory(), cache.get_stats().memory_used);
+}
+
+TEST("require that results larger than the memory budget are not stored") {
+    FilterResultCache cache(10);
+    cache.insert("a", 1, make_hits({1}));
+    EXPECT_TRUE(!cache.lookup("a", 1, docid_limit));
+    EXPECT_EQUAL(0u, cache.get_stats().entries);
+    EXPECT_EQUAL(0u, cache.get_stats().memory_used);
+}
+
+TEST("require that cached results can be searched both strict and non-strict") {
+    auto hits = make_hits({3, 7, 99});
+    SimpleResult expect;
+    expect.addHit(3).addHit(7).addHit(99);
+    for (bool strict: {false, true}) {
+        SearchIterator::UP search = FilterResultCache::create_search(hits, strict);
+        EXPECT_EQUAL(strict, search->is_strict() == vespalib::Trinary::True);
+        EXPECT_EQUAL(expect, collect(*search, strict));
+    }
+}
+
+TEST("require that filter subtrees are evaluated once and then served from the cache") {
+    FilterResultCache cache(1000000);
+    SimpleResult expect;
+    expect.addHit(5).addHit(10);
+    auto md = make_filter_match_data();
+    {
+        Blueprint::UP blueprint = make_and_blueprint({1, 5, 10}, {5, 10, 20});
+        static_cast<IntermediateBlueprint &>(*blueprint).setFilterCache(cache, "AND(a,b)", 1);
+        blueprint->setDocIdLimit(docid_limit);
+        SearchIterator::UP search = blueprint->createSearch(*md, true);
+        EXPECT_EQUAL(expect, collect(*search, true));
+    }
+    EXPECT_EQUAL(0u, cache.get_stats().hits);
+    EXPECT_EQUAL(1u, cache.get_stats().misses);
+    EXPECT_EQUAL(1u, cache.get_stats().entries);
+    {
+        // different children; the cached result is used since the key matches
+        Blueprint::UP blueprint = make_and_blueprint({1}, {1});
+        static_cast<IntermediateBlueprint &>(*blueprint).setFilterCache(cache, "AND(a,b)", 1);
+        blueprint->setDocIdLimit(docid_limit);
+        SearchIterator::UP search = blueprint->createSearch(*md, false);
+        EXPECT_EQUAL(expect, collect(*search, false));
+    }
+    EXPECT_EQUAL(1u, cache.get_stats().hits);
+    EXPECT_EQUAL(1u, cache.get_stats().misses);
+}
+
+TEST("require that the cache is not used when match data is needed") {
+    FilterResultCache cache(1000000);
+    SimpleResult expect;
+    expect.addHit(5).addHit(10);
+    MatchData::UP md = MatchData::makeTestInstance(1, 2);
+    Blueprint::UP blueprint = make_and_blueprint({1, 5, 10}, {5, 10, 20});
+    static_cast<IntermediateBlueprint &>(*blueprint).setFilterCache(cache, "AND(a,b)", 1);
+    blueprint->setDocIdLimit(docid_limit);
+    SearchIterator::UP search = blueprint->createSearch(*md, true);
+    EXPECT_EQUAL(expect, collect(*search, true));
+    EXPECT_EQUAL(0u, cache.get_stats().misses);
+    EXPECT_EQUAL(0u, cache.get_stats().entries);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,83 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/queryeval/packed_positions.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <algorithm>
+
+using namespace search::fef;
+using namespace search::queryeval;
+
+using Keys = std::vector<uint64_t>;
+
+uint64_t key(uint32_t element_id, uint32_t position) {
+    return PackedPositions::make_key(element_id, position);
+}
+
+Keys range(uint64_t begin, uint64_t end, uint64_t step) {
+    Keys keys;
+    for (uint64_t k = begin; k < end; k += step) {
+        keys.push_back(k);
+    }
+    return keys;
+}
+
+Keys intersect(Keys a, const Keys &b) {
+    PackedPositions::intersect(a, b);
+    return a;
+}
+
+Keys expect_intersect(const Keys &a, const Keys &b) {
+    Keys result;
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+TEST("require that keys are ordered by element id first and then by position") {
+    EXPECT_TRUE(key(0, 5) < key(0, 6));
+    EXPECT_TRUE(key(0, 0xffffffff) < key(1, 0));
+    EXPECT_TRUE(key(1, 0) < key(2, 0));
+    EXPECT_EQUAL(3u, PackedPositions::element_id(key(3, 7)));
+    EXPECT_EQUAL(7u, PackedPositions::position(key(3, 7)));
+}
+
+TEST("require that window end stays within the element") {
+    uint64_t end = PackedPositions::window_end(key(2, 10), 5);
+    EXPECT_EQUAL(key(2, 15), end);
+    EXPECT_TRUE(key(3, 0) > end);
+}
+
+TEST("require that positions can be appended with an offset") {
+    TermFieldMatchData tfmd;
+    tfmd.reset(1);
+    tfmd.appendPosition(TermFieldMatchDataPosition(0, 1, 1, 10));
+    tfmd.appendPosition(TermFieldMatchDataPosition(0, 4, 1, 10));
+    tfmd.appendPosition(TermFieldMatchDataPosition(2, 0, 1, 10));
+    tfmd.appendPosition(TermFieldMatchDataPosition(2, 3, 1, 10));
+    Keys keys;
+    PackedPositions::append(tfmd, 0, keys);
+    EXPECT_TRUE(Keys({key(0, 1), key(0, 4), key(2, 0), key(2, 3)}) == keys);
+    keys.clear();
+    PackedPositions::append(tfmd, 2, keys);
+    EXPECT_TRUE(Keys({key(0, 2), key(2, 1)}) == keys);
+}
+
+TEST("require that intersect keeps common keys only") {
+    EXPECT_TRUE(Keys() == intersect(Keys(), Keys({1, 2, 3})));
+    EXPECT_TRUE(Keys() == intersect(Keys({1, 2, 3}), Keys()));
+    EXPECT_TRUE(Keys({2, 3}) == intersect(Keys({1, 2, 3}), Keys({2, 3, 4})));
+    EXPECT_TRUE(Keys({key(1, 2)}) == intersect(Keys({key(0, 2), key(1, 2)}), Keys({key(1, 2), key(2, 2)})));
+}
+
+TEST("require that intersect skips blocks of keys correctly") {
+    Keys a = range(0, 1000, 3);
+    Keys b = range(0, 1000, 7);
+    Keys c = range(500, 520, 1);
+    EXPECT_TRUE(expect_intersect(a, b) == intersect(a, b));
+    EXPECT_TRUE(expect_intersect(b, a) == intersect(b, a));
+    EXPECT_TRUE(expect_intersect(a, c) == intersect(a, c));
+    EXPECT_TRUE(expect_intersect(c, a) == intersect(c, a));
+    EXPECT_TRUE(Keys({999}) == intersect(Keys({999}), a));
+    EXPECT_TRUE(Keys({0}) == intersect(Keys({0}), a));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
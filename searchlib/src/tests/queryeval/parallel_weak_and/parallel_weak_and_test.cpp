@@ -593,6 +593,8 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "        estHits: 2\n"
                               "        tree_size: 2\n"
                               "        allow_termwise_eval: 0\n"
+                              "        cost: 1\n"
+                              "        strict_cost: 1\n"
                               "    }\n"
                               "    sourceId: 4294967295\n"
                               "    docid_limit: 0\n"
@@ -614,6 +616,8 @@ TEST_F("require that asString() on blueprint works", BlueprintAsStringFixture)
                               "                estHits: 2\n"
                               "                tree_size: 1\n"
                               "                allow_termwise_eval: 1\n"
+                              "                cost: 1\n"
+                              "                strict_cost: 1\n"
                               "            }\n"
                               "            sourceId: 4294967295\n"
                               "            docid_limit: 0\n"
@@ -684,4 +688,50 @@ TEST("verify search iterator conformance") {
     }
 }
 
+struct SkewedWeightsFixture {
+    DocumentWeightAttributeHelper helper;
+    TermFieldMatchData tfmd;
+    DummyHeap heap;
+    std::vector<int32_t> weights;
+    std::vector<IDocumentWeightAttribute::LookupResult> dict_entries;
+    SkewedWeightsFixture() : helper(), tfmd(), heap(), weights({1, 1}), dict_entries() {
+        helper.add_docs(1000);
+        for (uint32_t docid = 1; docid < 1000; ++docid) {
+            helper.set_doc(docid, docid % 2, ((docid % 97) == 0) ? 100 : 1);
+        }
+        dict_entries.push_back(helper.dwa().lookup("0"));
+        dict_entries.push_back(helper.dwa().lookup("1"));
+    }
+    SimpleResult search(bool use_dwa, bool strict) {
+        SimpleResult hits;
+        MatchParams match_params(heap, 50, 1.0, 1);
+        match_params.setDocIdLimit(1000);
+        SearchIterator::UP search = create_wand(use_dwa, tfmd, match_params, weights, dict_entries, helper.dwa(), strict);
+        search->initRange(1, 1000);
+        for (uint32_t docid = 1; docid < 1000; ++docid) {
+            if (search->seek(docid)) {
+                search->unpack(docid);
+                EXPECT_EQUAL(100.0, tfmd.getRawScore());
+                hits.addHit(docid);
+            } else if (strict) {
+                docid = search->getDocId() - 1;
+            }
+        }
+        return hits;
+    }
+};
+
+TEST_F("require that posting list block max weights are used to skip documents without losing hits", SkewedWeightsFixture) {
+    SimpleResult expect;
+    for (uint32_t docid = 97; docid < 1000; docid += 97) {
+        expect.addHit(docid);
+    }
+    for (bool strict: {true, false}) {
+        for (bool use_dwa: {false, true}) {
+            TEST_STATE(vespalib::make_string("strict: %d, use_dwa: %d", strict, use_dwa).c_str());
+            EXPECT_EQUAL(expect, f1.search(use_dwa, strict));
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -276,6 +276,39 @@ TEST("require that termwise wrapper is rewindable") {
     TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
 }
 
+TEST("require that termwise evaluation works across multiple docid windows") {
+    // hits are spread to cover dense, sparse and empty windows
+    std::vector<uint32_t> hits;
+    for (uint32_t docid = 10; docid < 200000; docid += 3) {
+        hits.push_back(docid);
+    }
+    for (uint32_t docid: {300000, 300001, 2500000, 2999999}) {
+        hits.push_back(docid);
+    }
+    uint32_t begin = 5;
+    uint32_t end = 3000000;
+    std::vector<uint32_t> expect;
+    for (uint32_t docid: hits) {
+        if ((docid % 2) == 0) {
+            expect.push_back(docid);
+        }
+    }
+    std::vector<uint32_t> even;
+    for (uint32_t docid = 0; docid < end; docid += 2) {
+        even.push_back(docid);
+    }
+    for (bool strict_search: {true, false}) {
+        for (bool strict_wrapper: {true, false}) {
+            TEST_STATE(make_string("strict_search: %s, strict_wrapper: %s",
+                                   strict_search ? "true" : "false",
+                                   strict_wrapper ? "true" : "false").c_str());
+            auto search = make_termwise(UP(AND({new MyTerm(hits, true), new MyTerm(even, false)}, strict_search)), strict_wrapper);
+            TEST_DO(verify(expect, *search, begin, end));
+            TEST_DO(verify(expect, *search, begin, end));
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that leaf blueprints allow termwise evaluation by default") {
@@ -74,6 +74,7 @@ private:
 public:
     MultilevelSortTest() : _sortMethod(0) { srand(time(NULL)); }
     void testSortMethod(int method);
+    static size_t numSorted(const FastS_SortSpec &sortSpec) { return sortSpec._sortDataArray.size(); }
 };
 
 template<typename T>
@@ -429,4 +430,68 @@ TEST("test that [docid] translates to [lid][paritionid]") {
     EXPECT_EQUAL(0, memcmp(SECOND_DESC, sr2.first, 6));
 }
 
+TEST("require that sorting only the top hits on multiple keys gives the same top hits") {
+    vespalib::Clock clock;
+    vespalib::Doom doom(clock, fastos::ClockSystem::now() + fastos::TimeStamp::SEC*10);
+    search::uca::UcaConverterFactory ucaFactory;
+    search::AttributeManager mgr;
+    search::AttributeContext ac(mgr);
+    constexpr uint32_t num = 1000;
+    std::vector<RankedHit> all;
+    for (uint32_t i = 0; i < num; ++i) {
+        all.push_back(RankedHit((i * 7919) % num, (i % 7)));
+    }
+    FastS_SortSpec full(7, doom, ucaFactory);
+    EXPECT_TRUE(full.Init("-[rank] +[docid]", ac));
+    std::vector<RankedHit> expect = all;
+    full.sortResults(&expect[0], num, num);
+    for (uint32_t topn : {1u, 10u, 142u, 143u, 144u, 300u}) {
+        FastS_SortSpec top(7, doom, ucaFactory);
+        EXPECT_TRUE(top.Init("-[rank] +[docid]", ac));
+        std::vector<RankedHit> hits = all;
+        top.sortResults(&hits[0], num, topn);
+        for (uint32_t i = 0; i < topn; ++i) {
+            EXPECT_EQUAL(expect[i].getDocId(), hits[i].getDocId());
+            EXPECT_EQUAL(expect[i].getRank(), hits[i].getRank());
+            auto a = full.getSortRef(i);
+            auto b = top.getSortRef(i);
+            ASSERT_EQUAL(a.second, b.second);
+            EXPECT_EQUAL(0, memcmp(a.first, b.first, a.second));
+        }
+        std::vector<uint32_t> docIds;
+        for (const RankedHit & hit : hits) {
+            docIds.push_back(hit.getDocId());
+        }
+        std::sort(docIds.begin(), docIds.end());
+        for (uint32_t i = 0; i < num; ++i) {
+            EXPECT_EQUAL(i, docIds[i]);
+        }
+    }
+}
+
+TEST("require that preselection on the first key is skipped when it has too many ties") {
+    vespalib::Clock clock;
+    vespalib::Doom doom(clock, fastos::ClockSystem::now() + fastos::TimeStamp::SEC*10);
+    search::uca::UcaConverterFactory ucaFactory;
+    search::AttributeManager mgr;
+    search::AttributeContext ac(mgr);
+    constexpr uint32_t num = 1000;
+    constexpr uint32_t topn = 10;
+    for (uint32_t numTied : {num, num / 2 + 1, num / 2, 100u}) {
+        std::vector<RankedHit> hits;
+        for (uint32_t i = 0; i < num; ++i) {
+            uint32_t docId = (i * 7919) % num;
+            hits.push_back(RankedHit(docId, (docId < numTied) ? 1 : 0));
+        }
+        FastS_SortSpec sortSpec(7, doom, ucaFactory);
+        EXPECT_TRUE(sortSpec.Init("-[rank] +[docid]", ac));
+        sortSpec.sortResults(&hits[0], num, topn);
+        EXPECT_EQUAL((numTied > num / 2) ? num : numTied, MultilevelSortTest::numSorted(sortSpec));
+        for (uint32_t i = 0; i < topn; ++i) {
+            EXPECT_EQUAL(i, hits[i].getDocId());
+            EXPECT_EQUAL(1.0, hits[i].getRank());
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -90,6 +90,8 @@ private:
         uint32_t estHits = _search_context->approximateHits();
         HitEstimate estimate(estHits, estHits == 0);
         setEstimate(estimate);
+        // without a posting list index strict iteration scans all documents
+        set_strict_scan(!attribute.getIsFastSearch());
     }
 
 public:
@@ -126,6 +126,7 @@ AttributeVector::AttributeVector(vespalib::stringref baseFileName, const Config
       _uncommittedDocIdLimit(0u),
       _createSerialNum(0u),
       _compactLidSpaceGeneration(0u),
+      _committedUpdates(0u),
       _hasEnum(false),
       _loaded(false),
       _enableEnumeratedSave(false)
@@ -157,6 +158,7 @@ AttributeVector::commit(bool forceUpdateStat)
 {
     onCommit();
     updateCommittedDocIdLimit();
+    _committedUpdates.store(_status.getUpdateCount(), std::memory_order_release);
     updateStat(forceUpdateStat);
     _loaded = true;
 }
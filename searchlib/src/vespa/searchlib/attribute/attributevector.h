@@ -21,6 +21,7 @@
 #include <vespa/vespalib/objects/identifiable.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/fastos/time.h>
+#include <atomic>
 #include <cmath>
 #include <mutex>
 #include <shared_mutex>
@@ -282,6 +283,11 @@ public:
         return _genHandler.getCurrentGeneration();
     }
 
+    uint64_t getCommitGeneration() const override {
+        // in-place updates of single value attributes do not bump the generation
+        return getCurrentGeneration() + _committedUpdates.load(std::memory_order_acquire);
+    }
+
     /**
      * Used for unit testing. Must not be called from the thread owning the enum guard(s).
      */
@@ -580,6 +586,7 @@ private:
     uint32_t               _uncommittedDocIdLimit; // based on queued changes
     uint64_t               _createSerialNum;
     uint64_t               _compactLidSpaceGeneration; 
+    std::atomic<uint64_t>  _committedUpdates; // read by query threads
     bool                   _hasEnum;
     bool                   _loaded;
     bool                   _enableEnumeratedSave;
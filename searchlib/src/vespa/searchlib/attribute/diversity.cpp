@@ -4,6 +4,7 @@
 #include "singleenumattribute.h"
 #include "singlenumericattribute.h"
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <cstring>
 
 using std::make_unique;
 namespace search::attribute::diversity {
@@ -100,16 +101,39 @@ DiversityFilterT<Fetcher>::accepted(uint32_t docId) {
     return false;
 }
 
-std::unique_ptr<DiversityFilter>
-DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hits,
-                        size_t max_per_group,size_t cutoff_max_groups, bool cutoff_strict)
+template <typename Fetcher>
+class DocumentGrouperT final : public queryeval::HitCollector::DocumentGrouper {
+private:
+    Fetcher _diversity;
+
+    static uint64_t to_group(uint32_t value) { return value; }
+    static uint64_t to_group(int32_t value) { return value; }
+    static uint64_t to_group(int64_t value) { return value; }
+    static uint64_t to_group(float value) { return to_group(double(value)); }
+    static uint64_t to_group(double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+public:
+    DocumentGrouperT(Fetcher diversity) : _diversity(diversity) {}
+    uint64_t group(uint32_t docId) override { return to_group(_diversity.get(docId)); }
+};
+
+/**
+ * Creates an instance of the given template using the fastest
+ * available way of fetching values from the diversity attribute.
+ **/
+template <template <typename> class T, typename Base, typename ...Args>
+std::unique_ptr<Base>
+create_with_fetcher(const IAttributeVector &diversity_attr, const Args &...args)
 {
     if (diversity_attr.hasEnum()) { // must handle enum first
         FetchEnumFast fastEnum(diversity_attr);
         if (fastEnum.valid()) {
-            return make_unique<DiversityFilterT<FetchEnumFast>> (fastEnum, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchEnumFast>>(fastEnum, args...);
         } else {
-            return make_unique<DiversityFilterT<FetchEnum>>(FetchEnum(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchEnum>>(FetchEnum(diversity_attr), args...);
         }
     } else if (diversity_attr.isIntegerType()) {
         using FetchInt32Fast = FetchNumberFast<SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t> > >;
@@ -118,11 +142,11 @@ DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hi
         FetchInt32Fast fastInt32(diversity_attr);
         FetchInt64Fast fastInt64(diversity_attr);
         if (fastInt32.valid()) {
-            return make_unique<DiversityFilterT<FetchInt32Fast>>(fastInt32, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchInt32Fast>>(fastInt32, args...);
         } else if (fastInt64.valid()) {
-            return make_unique<DiversityFilterT<FetchInt64Fast>>(fastInt64, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchInt64Fast>>(fastInt64, args...);
         } else {
-            return make_unique<DiversityFilterT<FetchInteger>>(FetchInteger(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchInteger>>(FetchInteger(diversity_attr), args...);
         }
     } else if (diversity_attr.isFloatingPointType()) {
         using FetchFloatFast = FetchNumberFast<SingleValueNumericAttribute<FloatingPointAttributeTemplate<float> > >;
@@ -130,14 +154,27 @@ DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hi
         FetchFloatFast fastFloat(diversity_attr);
         FetchDoubleFast fastDouble(diversity_attr);
         if (fastFloat.valid()) {
-            return make_unique<DiversityFilterT<FetchFloatFast>>(fastFloat, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchFloatFast>>(fastFloat, args...);
         } else if (fastDouble.valid()) {
-            return make_unique<DiversityFilterT<FetchDoubleFast>>(fastDouble, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchDoubleFast>>(fastDouble, args...);
         } else {
-            return make_unique<DiversityFilterT<FetchFloat>>(FetchFloat(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<T<FetchFloat>>(FetchFloat(diversity_attr), args...);
         }
     }
-    return std::unique_ptr<DiversityFilter>();
+    return std::unique_ptr<Base>();
 }
 
+std::unique_ptr<DiversityFilter>
+DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hits,
+                        size_t max_per_group,size_t cutoff_max_groups, bool cutoff_strict)
+{
+    return create_with_fetcher<DiversityFilterT, DiversityFilter>(diversity_attr, max_per_group, cutoff_max_groups,
+                                                                  cutoff_strict, wanted_hits);
+}
+
+std::unique_ptr<queryeval::HitCollector::DocumentGrouper>
+create_document_grouper(const IAttributeVector &diversity_attr)
+{
+    return create_with_fetcher<DocumentGrouperT, queryeval::HitCollector::DocumentGrouper>(diversity_attr);
+}
 }
@@ -4,6 +4,7 @@
 
 #include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchlib/queryeval/idiversifier.h>
+#include <vespa/searchlib/queryeval/hitcollector.h>
 
 /**
  * This file contains low-level code used to implement diversified
@@ -69,6 +70,14 @@ protected:
     size_t _max_total;
 };
 
+/**
+ * Creates a document grouper placing hits with the same value in the
+ * diversity attribute in the same group. Returns an empty pointer if
+ * the attribute type is not supported.
+ **/
+std::unique_ptr<queryeval::HitCollector::DocumentGrouper>
+create_document_grouper(const IAttributeVector &diversity_attr);
+
 template <typename Result>
 class DiversityRecorder {
 private:
@@ -149,6 +149,11 @@ uint32_t ImportedAttributeVectorReadGuard::getCommittedDocIdLimit() const {
     return _reference_attribute.getCommittedDocIdLimit();
 }
 
+uint64_t ImportedAttributeVectorReadGuard::getCommitGeneration() const {
+    // both the target values and the lid mapping may change
+    return _reference_attribute.getCommitGeneration() + _target_attribute.getCommitGeneration();
+}
+
 bool ImportedAttributeVectorReadGuard::isImported() const
 {
     return true;
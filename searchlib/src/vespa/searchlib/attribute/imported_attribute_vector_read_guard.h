@@ -81,6 +81,7 @@ public:
     virtual bool getIsFilter() const override;
     virtual bool getIsFastSearch() const override;
     virtual uint32_t getCommittedDocIdLimit() const override;
+    virtual uint64_t getCommitGeneration() const override;
     virtual bool isImported() const override;
 
 protected:
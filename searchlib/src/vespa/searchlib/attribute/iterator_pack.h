@@ -43,6 +43,18 @@ public:
         return _children[ref].getData();
     }
 
+    // posting lists are btrees aggregating the max weight of each
+    // leaf node, which are used as blocks when skipping documents
+    static constexpr bool has_block_max = true;
+
+    int32_t get_block_max_weight(uint16_t ref) const {
+        return _children[ref].getLeafAggregated().getMax();
+    }
+
+    uint32_t get_block_end(uint16_t ref) const {
+        return _children[ref].getLeafLastKey();
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
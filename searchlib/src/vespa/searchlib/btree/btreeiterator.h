@@ -347,6 +347,26 @@ public:
         return _leaf.getData();
     }
 
+    /**
+     * Get aggregated values for the leaf node containing the current
+     * iterator location. Iterator must be valid.
+     */
+    const AggrT &
+    getLeafAggregated() const
+    {
+        return _leaf.getNode()->getAggregated();
+    }
+
+    /**
+     * Get last key in the leaf node containing the current iterator
+     * location. Iterator must be valid.
+     */
+    const KeyType &
+    getLeafLastKey() const
+    {
+        return _leaf.getNode()->getLastKey();
+    }
+
     /**
      * Check if iterator is at a valid element, i.e. not at end.
      */
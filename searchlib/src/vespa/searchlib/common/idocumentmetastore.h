@@ -144,6 +144,14 @@ struct IDocumentMetaStore {
      */
     virtual LidUsageStats getLidUsageStats() const = 0;
 
+    /**
+     * Returns true if lids are known to have been assigned in feed
+     * order, i.e. a document fed later never has a lower lid than a
+     * document fed earlier. This no longer holds once lids are reused
+     * after removes or documents are moved by lid space compaction.
+     */
+    virtual bool isLidSpaceInFeedOrder() const = 0;
+
     /**
      * Creates a white list blueprint that returns a search iterator
      * that gives hits for all documents that should be visible.
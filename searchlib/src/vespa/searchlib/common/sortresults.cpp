@@ -215,12 +215,13 @@ FastS_SortSpec::realloc(uint32_t n, size_t & variableWidth, uint32_t & available
 }
 
 void
-FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
+FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n, size_t numVectors)
 {
     freeSortData();
     size_t fixedWidth = 0;
     size_t variableWidth = 0;
-    for (auto iter = _vectors.begin(); iter != _vectors.end(); ++iter) {
+    auto vectorsEnd = _vectors.begin() + numVectors;
+    for (auto iter = _vectors.begin(); iter != vectorsEnd; ++iter) {
         if (iter->_type >= ASC_DOCID) { // doc id
             fixedWidth += sizeof(uint32_t) + sizeof(uint16_t);
         }else if (iter->_type >= ASC_RANK) { // rank value
@@ -244,7 +245,7 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
     document::GlobalId gid;
     for (uint32_t i(0), idx(0); (i < n) && !_doom.doom(); ++i) {
         uint32_t len = 0;
-        for (auto iter = _vectors.begin(); iter != _vectors.end(); ++iter) {
+        for (auto iter = _vectors.begin(); iter != vectorsEnd; ++iter) {
             int written(0);
             if (available < std::max(sizeof(hits->_docId) + sizeof(_partitionId), sizeof(hits->_rankValue))) {
                 mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
@@ -373,7 +374,7 @@ FastS_SortSpec::freeSortData()
 void
 FastS_SortSpec::initWithoutSorting(const RankedHit * hits, uint32_t hitCnt)
 {
-    initSortData(hits, hitCnt);
+    initSortData(hits, hitCnt, _vectors.size());
 }
 
 inline int
@@ -477,9 +478,8 @@ public:
 
 
 void
-FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
+FastS_SortSpec::sortSortData(uint32_t n, uint32_t topn)
 {
-    initSortData(a, n);
     SortData * sortData = &_sortDataArray[0];
     if (_method == 0) {
         search::qsort<7, 40, SortData, FastS_SortSpec>(sortData, n, this);
@@ -489,6 +489,60 @@ FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
         Array<uint32_t> radixScratchPad(n, Alloc::alloc(0, MMAP_LIMIT));
         search::radix_sort(SortDataRadix(&_binarySortData[0]), StdSortDataCompare(&_binarySortData[0]), SortDataEof(), 1, sortData, n, &radixScratchPad[0], 0, 96, topn);
     }
+}
+
+/**
+ * Sorts on the first sort key only, and moves the hits that are
+ * ahead of or tied with the topn'th hit on that key to the front.
+ * The sort data of each key is prefix free, so no other hit can end
+ * up among the topn first when sorting on all keys. When the first
+ * key has so many ties that more than half of the hits are candidates,
+ * the hits are left as they are and all of them must be sorted on
+ * all keys.
+ *
+ * @return the number of hits moved to the front
+ **/
+uint32_t
+FastS_SortSpec::preselectTopN(RankedHit a[], uint32_t n, uint32_t topn)
+{
+    initSortData(a, n, 1);
+    if (_doom.doom()) {
+        return n;
+    }
+    sortSortData(n, topn);
+    StdSortDataCompare cmp(&_binarySortData[0]);
+    const SortData & last = _sortDataArray[topn - 1];
+    uint32_t numCandidates(topn);
+    for (uint32_t i(topn); i < n; ++i) {
+        if (cmp.cmp(_sortDataArray[i], last) <= 0) {
+            ++numCandidates;
+        }
+    }
+    if (numCandidates > n / 2) {
+        return n;
+    }
+    uint32_t i(0);
+    uint32_t j(numCandidates);
+    for (const SortData & sd : _sortDataArray) {
+        if (cmp.cmp(sd, last) <= 0) {
+            a[i++] = sd;
+        } else {
+            a[j++] = sd;
+        }
+    }
+    return numCandidates;
+}
+
+void
+FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
+{
+    uint32_t numSorted(n);
+    if ((_vectors.size() > 1) && (topn > 0) && (topn < n / 2)) {
+        // Avoid producing sort data for the remaining keys of hits that cannot make it to the top
+        numSorted = preselectTopN(a, n, topn);
+    }
+    initSortData(a, numSorted, _vectors.size());
+    sortSortData(numSorted, topn);
     for (uint32_t i(0), m(_sortDataArray.size()); i < m; ++i) {
         a[i]._rankValue = _sortDataArray[i]._rankValue;
         a[i]._docId = _sortDataArray[i]._docId;
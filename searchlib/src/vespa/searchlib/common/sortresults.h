@@ -108,7 +108,9 @@ private:
     SortDataArray            _sortDataArray;
 
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::SortInfo & sInfo);
-    void initSortData(const search::RankedHit *a, uint32_t n);
+    void initSortData(const search::RankedHit *a, uint32_t n, size_t numVectors);
+    void sortSortData(uint32_t n, uint32_t topn);
+    uint32_t preselectTopN(search::RankedHit a[], uint32_t n, uint32_t topn);
     uint8_t * realloc(uint32_t n, size_t & variableWidth, uint32_t & available, uint32_t & dataSize, uint8_t *mySortData);
 
 public:
@@ -95,12 +95,18 @@ Chunk::getLid(uint32_t lid) const
             assert(bLen == it->netSize());
             assert((bLen + 2*sizeof(uint32_t)) == it->size());
 #endif
-            buf = vespalib::ConstBufferRef(getData().c_str() + it->getNetOffset(), it->netSize());
+            buf = getLid(*it);
         }
     }
     return buf;
 }
 
+vespalib::ConstBufferRef
+Chunk::getLid(const Entry & entry) const
+{
+    return vespalib::ConstBufferRef(getData().c_str() + entry.getNetOffset(), entry.netSize());
+}
+
 size_t
 Chunk::size() const {
     return getData().size();
@@ -100,6 +100,7 @@ public:
     uint32_t getId() const { return _id; }
     bool validSerial() const { return getLastSerial() != static_cast<uint64_t>(-1l); }
     vespalib::ConstBufferRef getLid(uint32_t lid) const;
+    vespalib::ConstBufferRef getLid(const Entry & entry) const;
     const vespalib::nbostream & getData() const;
     bool hasRoom(size_t len) const;
     MemoryUsage getMemoryUsage() const;
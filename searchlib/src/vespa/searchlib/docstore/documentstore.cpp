@@ -110,11 +110,89 @@ using CacheParams = vespalib::CacheParam<
         vespalib::zero<DocumentIdT>,
         vespalib::size<docstore::Value> >;
 
-class Cache : public vespalib::cache<CacheParams> {
+/**
+ * The cache used by DocumentStore::read. It is split in shards selected by lid, each with
+ * its own lock, so that concurrent summary lookups do not contend on a single lock. Each
+ * shard is a segmented LRU, where documents read more than once are protected from being
+ * evicted by reads touching many documents once, e.g. get operations or partial updates
+ * applied to all documents. Visiting does not use this cache, it reads through the visit
+ * cache, which protects repeatedly visited sets the same way, or directly from the backing store.
+ */
+class Cache {
 public:
-    Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
+    Cache(BackingStore & b, size_t maxBytes);
+    ~Cache();
+    Value read(DocumentIdT lid) { return getShard(lid).read(lid); }
+    void write(DocumentIdT lid, Value value) { getShard(lid).write(lid, std::move(value)); }
+    void invalidate(DocumentIdT lid) { getShard(lid).invalidate(lid); }
+    bool hasKey(DocumentIdT lid) const { return getShard(lid).hasKey(lid); }
+    void reserveElements(size_t elems);
+    void setCapacityBytes(size_t sz);
+    size_t capacityBytes() const { return _maxBytes; }
+    size_t capacity() const { return _shards[0]->capacity(); }
+    CacheStats getStats() const;
+    std::vector<CacheStats> getShardStats() const;
+private:
+    using Shard = vespalib::cache<CacheParams>;
+    static constexpr size_t NUM_SHARDS = 16;
+    // Share of each shard kept for documents read more than once, in percent.
+    static constexpr size_t PROTECTED_PERCENT = 80;
+    Shard & getShard(DocumentIdT lid) { return *_shards[lid % NUM_SHARDS]; }
+    const Shard & getShard(DocumentIdT lid) const { return *_shards[lid % NUM_SHARDS]; }
+    size_t                              _maxBytes;
+    std::vector<std::unique_ptr<Shard>> _shards;
 };
 
+Cache::Cache(BackingStore & b, size_t maxBytes)
+    : _maxBytes(0),
+      _shards()
+{
+    _shards.reserve(NUM_SHARDS);
+    for (size_t i(0); i < NUM_SHARDS; i++) {
+        _shards.push_back(std::make_unique<Shard>(b, 0));
+    }
+    setCapacityBytes(maxBytes);
+}
+
+Cache::~Cache() = default;
+
+void
+Cache::reserveElements(size_t elems) {
+    for (auto & shard : _shards) {
+        shard->reserveElements(elems / NUM_SHARDS);
+    }
+}
+
+void
+Cache::setCapacityBytes(size_t sz) {
+    _maxBytes = sz;
+    size_t shardBytes = sz / NUM_SHARDS;
+    for (auto & shard : _shards) {
+        shard->setCapacityBytes(shardBytes);
+        shard->setProtectedCapacityBytes((shardBytes / 100) * PROTECTED_PERCENT);
+    }
+}
+
+CacheStats
+Cache::getStats() const {
+    CacheStats stats;
+    for (const CacheStats & shardStats : getShardStats()) {
+        stats += shardStats;
+    }
+    return stats;
+}
+
+std::vector<CacheStats>
+Cache::getShardStats() const {
+    std::vector<CacheStats> stats;
+    stats.reserve(_shards.size());
+    for (const auto & shard : _shards) {
+        stats.emplace_back(shard->getHit(), shard->getMiss(), shard->size(), shard->sizeBytes(), shard->getInvalidate(),
+                           shard->getEvict());
+    }
+    return stats;
+}
+
 }
 
 using VisitCache = docstore::VisitCache;
@@ -436,12 +514,17 @@ DocumentStore::getFileChunkStats() const
 
 CacheStats DocumentStore::getCacheStats() const {
     CacheStats visitStats = _visitCache->getCacheStats();
-    CacheStats singleStats(_cache->getHit(), _cache->getMiss() + _uncached_lookups,
-                           _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
+    CacheStats singleStats = _cache->getStats();
+    singleStats.misses += _uncached_lookups;
     singleStats += visitStats;
     return singleStats;
 }
 
+std::vector<CacheStats>
+DocumentStore::getCacheShardStats() const {
+    return _cache->getShardStats();
+}
+
 void
 DocumentStore::compactLidSpace(uint32_t wantedDocLidLimit)
 {
@@ -82,6 +82,11 @@ public:
     size_t      getDiskBloat() const override { return _backingStore.getDiskBloat(); }
     size_t getMaxCompactGain() const override { return _backingStore.getMaxCompactGain(); }
     CacheStats getCacheStats() const override;
+    /**
+     * Returns the statistics of each shard of the document cache, in shard order. The sum
+     * of these, plus lookups not using the cache and the visit cache, is reported by getCacheStats.
+     */
+    std::vector<CacheStats> getCacheShardStats() const override;
     size_t memoryMeta() const override { return _backingStore.memoryMeta(); }
     const vespalib::string & getBaseDir() const override { return _backingStore.getBaseDir(); }
     void accept(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
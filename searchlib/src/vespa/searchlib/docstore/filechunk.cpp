@@ -385,11 +385,28 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
     Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    if (count == 1) {
+        vespalib::ConstBufferRef buf = chunk.getLid(begin->getLid());
+        if (buf.size() != 0) {
+            visitor.visit(begin->getLid(), buf);
+        }
+        return;
+    }
+    // Index the chunk once instead of scanning all its entries for every
+    // requested lid. Later entries for the same lid override earlier ones.
+    vespalib::hash_map<uint32_t, uint32_t> entryIndex(2*chunk.getLids().size());
+    const Chunk::LidList & entries = chunk.getLids();
+    for (uint32_t i(0); i < entries.size(); i++) {
+        entryIndex[entries[i].getLid()] = i;
+    }
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
-        vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
-        if (buf.size() != 0) {
-            visitor.visit(li.getLid(), buf);
+        auto found = entryIndex.find(li.getLid());
+        if (found != entryIndex.end()) {
+            vespalib::ConstBufferRef buf = chunk.getLid(entries[found->second]);
+            if (buf.size() != 0) {
+                visitor.visit(li.getLid(), buf);
+            }
         }
     }
 }
@@ -176,6 +176,11 @@ public:
      */
     virtual CacheStats getCacheStats() const = 0;
 
+    /**
+     * Returns statistics about each shard of the cache, if the cache is sharded.
+     */
+    virtual std::vector<CacheStats> getCacheShardStats() const = 0;
+
     /**
      * Returns the base directory from which all structures are stored.
      **/
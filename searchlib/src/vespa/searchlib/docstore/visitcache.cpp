@@ -157,12 +157,14 @@ VisitCache::VisitCache(IDataStore &store, size_t cacheSize, const CompressionCon
     _store(store, compression),
     _cache(std::make_unique<Cache>(_store, cacheSize))
 {
+    _cache->setProtectedCapacityBytes((cacheSize / 100) * PROTECTED_PERCENT);
 }
 
 void
 VisitCache::reconfigure(size_t cacheSize, const CompressionConfig &compression) {
     _store.reconfigure(compression);
     _cache->setCapacityBytes(cacheSize);
+    _cache->setProtectedCapacityBytes((cacheSize / 100) * PROTECTED_PERCENT);
 }
 
 
@@ -221,7 +223,8 @@ VisitCache::remove(uint32_t key) {
 
 CacheStats
 VisitCache::getCacheStats() const {
-    return CacheStats(_cache->getHit(), _cache->getMiss(), _cache->size(), _cache->sizeBytes(), _cache->getInvalidate());
+    return CacheStats(_cache->getHit(), _cache->getMiss(), _cache->size(), _cache->sizeBytes(), _cache->getInvalidate(),
+                      _cache->getEvict());
 }
 
 VisitCache::Cache::Cache(BackingStore & b, size_t maxBytes) :
@@ -95,6 +95,8 @@ private:
  * Caches a set of objects as a set.
  * The objects are compressed together as a set.
  * The whole set is invalidated when one object of its objects are removed.
+ * Sets that are visited again are protected, so that a full visit of the
+ * document store does not flush them.
  **/
 class VisitCache {
 public:
@@ -108,6 +110,8 @@ public:
     CacheStats getCacheStats() const;
     void reconfigure(size_t cacheSize, const CompressionConfig &compression);
 private:
+    // Share of the cache kept for sets visited more than once, in percent.
+    static constexpr size_t PROTECTED_PERCENT = 80;
     /**
      * This implments the interface the cache uses when it has a cache miss.
      * It wraps an IDataStore. Given a set of lids it will visit all objects
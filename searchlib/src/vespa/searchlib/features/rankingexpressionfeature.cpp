@@ -2,6 +2,7 @@
 
 #include "rankingexpressionfeature.h"
 #include "utils.h"
+#include <vespa/searchlib/fef/batch_feature_executor.h>
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
@@ -43,19 +44,28 @@ vespalib::string list_issues(const std::vector<vespalib::string> &issues) {
 //-----------------------------------------------------------------------------
 
 /**
- * Implements the executor for compiled ranking expressions
+ * Implements the executor for compiled ranking expressions. Supports
+ * batch evaluation, used when re-ranking hits in the second phase.
  **/
-class CompiledRankingExpressionExecutor : public fef::FeatureExecutor
+class CompiledRankingExpressionExecutor : public fef::BatchFeatureExecutor
 {
 private:
     typedef double (*arr_function)(const double *);
+    const CompiledFunction &_compiled_function;
     arr_function _ranking_function;
     std::vector<double> _params;
+    ConstArrayRef<fef::LazyValue> _batch_inputs;
+
+protected:
+    void handle_bind_inputs(ConstArrayRef<fef::LazyValue> inputs) override;
 
 public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    size_t num_batch_inputs() const override { return _params.size(); }
+    void gather_batch_inputs(uint32_t docid, double *dst) override;
+    void execute_batch(const double *inputs, size_t num_docs, double *results) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -111,11 +121,19 @@ public:
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
-    : _ranking_function(compiled_function.get_function()),
-      _params(compiled_function.num_params(), 0.0)
+    : _compiled_function(compiled_function),
+      _ranking_function(compiled_function.get_function()),
+      _params(compiled_function.num_params(), 0.0),
+      _batch_inputs()
 {
 }
 
+void
+CompiledRankingExpressionExecutor::handle_bind_inputs(ConstArrayRef<fef::LazyValue> inputs)
+{
+    _batch_inputs = inputs;
+}
+
 void
 CompiledRankingExpressionExecutor::execute(uint32_t)
 {
@@ -132,6 +150,20 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(&_params[0]));
 }
 
+void
+CompiledRankingExpressionExecutor::gather_batch_inputs(uint32_t docid, double *dst)
+{
+    for (size_t i = 0; i < _batch_inputs.size(); ++i) {
+        dst[i] = _batch_inputs[i].as_number(docid);
+    }
+}
+
+void
+CompiledRankingExpressionExecutor::execute_batch(const double *inputs, size_t num_docs, double *results)
+{
+    _compiled_function.eval_batch(inputs, num_docs, results);
+}
+
 //-----------------------------------------------------------------------------
 
 using Context = fef::FeatureExecutor::Inputs;
@@ -0,0 +1,39 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "featureexecutor.h"
+
+namespace search::fef {
+
+/**
+ * A feature executor producing a single number that is also able to
+ * calculate its output for a batch of documents at once. Inputs are
+ * gathered one document at a time, since they may depend on match
+ * data that is only valid for the most recently unpacked document,
+ * while the output is calculated for all gathered documents together.
+ * Batch evaluation does not change the value observed through the
+ * outputs of the executor.
+ **/
+class BatchFeatureExecutor : public FeatureExecutor
+{
+public:
+    /**
+     * The number of values gathered for each document.
+     **/
+    virtual size_t num_batch_inputs() const = 0;
+
+    /**
+     * Gather the inputs for the given document into 'dst', which
+     * must have room for num_batch_inputs() values.
+     **/
+    virtual void gather_batch_inputs(uint32_t docid, double *dst) = 0;
+
+    /**
+     * Calculate the output for 'num_docs' documents whose inputs are
+     * stored back to back in 'inputs'.
+     **/
+    virtual void execute_batch(const double *inputs, size_t num_docs, double *results) = 0;
+};
+
+}
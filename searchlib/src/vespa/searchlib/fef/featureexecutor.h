@@ -28,6 +28,7 @@ public:
     LazyValue(const NumberOrObject *value, FeatureExecutor *executor)
         : _value(value), _executor(executor) {}
     bool is_const() const { return (_executor == nullptr); }
+    FeatureExecutor *executor() const { return _executor; }
     bool is_same(const LazyValue &rhs) const {
         return ((_value == rhs._value) && (_executor == rhs._executor));
     }
@@ -262,6 +262,66 @@ MinHitsPerThread::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string FilterCacheMaxMemory::NAME("vespa.matching.filter_cache_max_memory");
+const uint32_t FilterCacheMaxMemory::DEFAULT_VALUE(0);
+
+uint32_t
+FilterCacheMaxMemory::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+FilterCacheMaxMemory::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheSize::NAME("vespa.matching.result_cache_size");
+const uint32_t ResultCacheSize::DEFAULT_VALUE(0);
+
+uint32_t
+ResultCacheSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ResultCacheMaxMemory::NAME("vespa.matching.result_cache_max_memory");
+const uint32_t ResultCacheMaxMemory::DEFAULT_VALUE(16 * 1024 * 1024);
+
+uint32_t
+ResultCacheMaxMemory::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ResultCacheMaxMemory::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string StaticRankOrderHits::NAME("vespa.matching.static_rank_order_hits");
+const uint32_t StaticRankOrderHits::DEFAULT_VALUE(0);
+
+uint32_t
+StaticRankOrderHits::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+StaticRankOrderHits::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -444,6 +504,24 @@ RankScoreDropLimit::lookup(const Properties &props)
     return lookupDouble(props, NAME, DEFAULT_VALUE);
 }
 
+const vespalib::string DiversityAttribute::NAME("vespa.hitcollector.diversity.attribute");
+const vespalib::string DiversityAttribute::DEFAULT_VALUE("");
+
+vespalib::string
+DiversityAttribute::lookup(const Properties &props, const vespalib::string & defaultValue)
+{
+    return lookupString(props, NAME, defaultValue);
+}
+
+const vespalib::string DiversityMaxHitsPerGroup::NAME("vespa.hitcollector.diversity.maxhitspergroup");
+const uint32_t DiversityMaxHitsPerGroup::DEFAULT_VALUE(0);
+
+uint32_t
+DiversityMaxHitsPerGroup::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 } // namspace hitcollector
 
 
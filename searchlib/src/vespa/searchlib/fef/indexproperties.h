@@ -175,6 +175,60 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property for the number of bytes used to cache the hits of
+     * filter subtrees shared by many queries. The cache is shared by
+     * all queries using the same rank profile. The default value is 0
+     * (no caching).
+     **/
+    struct FilterCacheMaxMemory {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for the number of complete search results cached for
+     * repeated identical queries. Cached results are dropped when the
+     * searchable data changes. The cache is shared by all queries
+     * using the same rank profile. The default value is 0 (no
+     * caching).
+     **/
+    struct ResultCacheSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for the number of bytes the result cache may use for
+     * cached search results. Least recently used results are evicted
+     * to stay within this budget. The default value is 16 MiB.
+     **/
+    struct ResultCacheMaxMemory {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for the number of hits after which matching may stop
+     * when local docids are assigned in order of decreasing static
+     * rank, so that the best documents have the lowest docids. The
+     * docid space is then searched in increasing order, and no more
+     * docids are searched once this many hits have been found. This
+     * is ignored when the document meta store can not guarantee
+     * that docids are in feed order (after lid reuse or lid space
+     * compaction), and when sorting or grouping. A query may set
+     * this to 0 to get exact matching. The default value is 0
+     * (exact matching).
+     **/
+    struct StaticRankOrderHits {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 }
 
 namespace softtimeout {
@@ -362,6 +416,33 @@ namespace hitcollector {
         static feature_t lookup(const Properties &props);
     };
 
+    /**
+     * The name of the attribute used to group hits when collecting
+     * the best ranked hits. If this property is "" (empty string; the
+     * default) the ranked hits are not grouped.
+     **/
+    struct DiversityAttribute {
+        static const vespalib::string NAME;
+        static const vespalib::string DEFAULT_VALUE;
+        static vespalib::string lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+        static vespalib::string lookup(const Properties &props, const vespalib::string & defaultValue);
+    };
+
+    /**
+     * The maximum number of ranked hits kept for each value of the
+     * diversity attribute during first phase collection, re-ranking
+     * and in the merged result. If this property is 0 (the default)
+     * the number of hits per group is not limited. When match phase
+     * diversity is also enabled, that takes precedence when selecting
+     * hits for re-ranking, using the lower of the two per group
+     * limits if both use the same attribute.
+     **/
+    struct DiversityMaxHitsPerGroup {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
 
 } // namespace hitcollector
 
@@ -37,6 +37,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
+      _staticRankOrderHits(0),
       _heapSize(0),
       _arraySize(0),
       _estimatePoint(0),
@@ -56,6 +57,8 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _diversityMinGroups(1),
       _diversityCutoffFactor(10.0),
       _diversityCutoffStrategy("loose"),
+      _hitDiversityAttribute(),
+      _hitDiversityMaxHitsPerGroup(0),
       _softTimeoutEnabled(false),
       _softTimeoutTailCost(0.1)
 { }
@@ -80,6 +83,7 @@ RankSetup::configure()
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    setStaticRankOrderHits(matching::StaticRankOrderHits::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -95,6 +99,8 @@ RankSetup::configure()
     setEstimatePoint(hitcollector::EstimatePoint::lookup(_indexEnv.getProperties()));
     setEstimateLimit(hitcollector::EstimateLimit::lookup(_indexEnv.getProperties()));
     setRankScoreDropLimit(hitcollector::RankScoreDropLimit::lookup(_indexEnv.getProperties()));
+    setHitDiversityAttribute(hitcollector::DiversityAttribute::lookup(_indexEnv.getProperties()));
+    setHitDiversityMaxHitsPerGroup(hitcollector::DiversityMaxHitsPerGroup::lookup(_indexEnv.getProperties()));
     setSoftTimeoutEnabled(softtimeout::Enabled::lookup(_indexEnv.getProperties()));
     setSoftTimeoutTailCost(softtimeout::TailCost::lookup(_indexEnv.getProperties()));
     setSoftTimeoutFactor(softtimeout::Factor::lookup(_indexEnv.getProperties()));
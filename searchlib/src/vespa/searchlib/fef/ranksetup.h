@@ -35,6 +35,7 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    uint32_t                 _staticRankOrderHits;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -54,6 +55,8 @@ private:
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
     vespalib::string         _diversityCutoffStrategy;
+    vespalib::string         _hitDiversityAttribute;
+    uint32_t                 _hitDiversityMaxHitsPerGroup;
     bool                     _softTimeoutEnabled;
     double                   _softTimeoutTailCost;
     double                   _softTimeoutFactor;
@@ -157,6 +160,22 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    /**
+     * Sets the number of hits after which matching may stop when
+     * docids are ordered by static rank. 0 means exact matching.
+     *
+     * @param staticRankOrderHits the number of hits
+     **/
+    void setStaticRankOrderHits(uint32_t staticRankOrderHits) { _staticRankOrderHits = staticRankOrderHits; }
+
+    /**
+     * Returns the number of hits after which matching may stop when
+     * docids are ordered by static rank.
+     *
+     * @return the number of hits
+     **/
+    uint32_t getStaticRankOrderHits() const { return _staticRankOrderHits; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -319,6 +338,18 @@ public:
      **/
     feature_t getRankScoreDropLimit() const { return _rankScoreDropLimit; }
 
+    /** set name of attribute used to group the ranked hits in the hit collector */
+    void setHitDiversityAttribute(const vespalib::string &value) { _hitDiversityAttribute = value; }
+
+    /** get name of attribute used to group the ranked hits in the hit collector */
+    const vespalib::string &getHitDiversityAttribute() const { return _hitDiversityAttribute; }
+
+    /** set the maximum number of ranked hits kept per group in the hit collector */
+    void setHitDiversityMaxHitsPerGroup(uint32_t value) { _hitDiversityMaxHitsPerGroup = value; }
+
+    /** get the maximum number of ranked hits kept per group in the hit collector */
+    uint32_t getHitDiversityMaxHitsPerGroup() const { return _hitDiversityMaxHitsPerGroup; }
+
     /**
      * This method may be used to indicate that certain features
      * should be present in the docsum.
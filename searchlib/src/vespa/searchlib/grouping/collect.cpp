@@ -86,7 +86,12 @@ Collect::createCollectors(GroupRef gr)
 {
     size_t offset(getAggrBase(gr));
     if (offset == _aggrBacking.size()) {
-        _aggrBacking.resize(getAggrBase(GroupRef(gr.getRef() + 1)));
+        size_t newSize(getAggrBase(GroupRef(gr.getRef() + 1)));
+        if (newSize > _aggrBacking.capacity()) {
+            // resize only reserves what is asked for, so reserve ahead
+            _aggrBacking.reserve(vespalib::roundUp2inN(newSize));
+        }
+        _aggrBacking.resize(newSize);
         uint8_t * base(&_aggrBacking[offset]);
         for (size_t i(0), m(_aggregator.size()); i < m; i++) {
             ResultAccessor & r = _aggregator[i];
@@ -119,7 +119,12 @@ int GroupEngine::cmpRank(GroupRef a, GroupRef b) const
 GroupRef GroupEngine::createGroup(const search::expression::ResultNode & v)
 {
     GroupRef gr(_idByteSize ? _ids.size()/_idByteSize : 0);
-    _ids.resize(getIdBase(GroupRef(gr + 1)));
+    size_t newSize(getIdBase(GroupRef(gr + 1)));
+    if (newSize > _ids.capacity()) {
+        // avoid reallocating the ids for every new group
+        _ids.reserve(vespalib::roundUp2inN(newSize));
+    }
+    _ids.resize(newSize);
     uint8_t * base(&_ids[getIdBase(gr)]);
     v.create(base);
     v.encode(base);
@@ -4,10 +4,13 @@
 #include "leaf_blueprints.h"
 #include "intermediate_blueprints.h"
 #include "equiv_blueprint.h"
+#include "filter_result_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <vespa/vespalib/objects/objectdumper.h>
 #include <vespa/vespalib/util/classname.h>
 #include <map>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".queryeval.blueprint");
@@ -65,7 +68,9 @@ Blueprint::State::State(const FieldSpecBaseList &fields_in)
     : _fields(fields_in),
       _estimate(),
       _tree_size(1),
-      _allow_termwise_eval(true)
+      _allow_termwise_eval(true),
+      _cost(1.0),
+      _strict_scan(false)
 {
 }
 
@@ -109,6 +114,16 @@ Blueprint::root() const
     return *bp;
 }
 
+double
+Blueprint::strict_cost() const
+{
+    const State &state = getState();
+    if (state.strict_scan() || (get_docid_limit() == 0)) {
+        return cost();
+    }
+    return hit_ratio() * cost();
+}
+
 vespalib::string
 Blueprint::asString() const
 {
@@ -145,6 +160,8 @@ Blueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     visitor.visitInt("estHits", state.estimate().estHits);
     visitor.visitInt("tree_size", state.tree_size());
     visitor.visitInt("allow_termwise_eval", state.allow_termwise_eval());
+    visitor.visitFloat("cost", cost());
+    visitor.visitFloat("strict_cost", strict_cost());
     visitor.closeStruct();
     visitor.visitInt("sourceId", _sourceId);
     visitor.visitInt("docid_limit", _docid_limit);
@@ -165,6 +182,16 @@ StateCache::updateState() const
 
 //-----------------------------------------------------------------------------
 
+struct IntermediateBlueprint::CachedFilter {
+    FilterResultCache                 &cache;
+    vespalib::string                   key;
+    uint64_t                           generation;
+    std::mutex                         lock;
+    FilterResultCache::BitVectorSP     result;
+    CachedFilter(FilterResultCache &cache_in, const vespalib::string &key_in, uint64_t generation_in)
+        : cache(cache_in), key(key_in), generation(generation_in), lock(), result() {}
+};
+
 IntermediateBlueprint::~IntermediateBlueprint()
 {
     while (!_children.empty()) {
@@ -314,6 +341,33 @@ IntermediateBlueprint::optimize(Blueprint* &self)
 
 SearchIterator::UP
 IntermediateBlueprint::createSearch(fef::MatchData &md, bool strict) const
+{
+    if (_cached_filter && (get_docid_limit() > 0) && calculateUnpackInfo(md).empty()) {
+        return createCachedFilterSearch(md, strict);
+    }
+    return createUncachedSearch(md, strict);
+}
+
+SearchIterator::UP
+IntermediateBlueprint::createCachedFilterSearch(fef::MatchData &md, bool strict) const
+{
+    CachedFilter &filter = *_cached_filter;
+    std::lock_guard<std::mutex> guard(filter.lock);
+    if (!filter.result) {
+        uint32_t docid_limit = get_docid_limit();
+        filter.result = filter.cache.lookup(filter.key, filter.generation, docid_limit);
+        if (!filter.result) {
+            SearchIterator::UP search = createUncachedSearch(md, true);
+            search->initRange(1, docid_limit);
+            filter.result = search->get_hits(1);
+            filter.cache.insert(filter.key, filter.generation, filter.result);
+        }
+    }
+    return FilterResultCache::create_search(filter.result, strict);
+}
+
+SearchIterator::UP
+IntermediateBlueprint::createUncachedSearch(fef::MatchData &md, bool strict) const
 {
     MultiSearch::Children subSearches;
     subSearches.reserve(_children.size());
@@ -325,8 +379,40 @@ IntermediateBlueprint::createSearch(fef::MatchData &md, bool strict) const
     return createIntermediateSearch(subSearches, strict, md);
 }
 
+double
+IntermediateBlueprint::cost() const
+{
+    double total = 0.0;
+    for (const Blueprint * child : _children) {
+        total += child->cost();
+    }
+    return total;
+}
+
+double
+IntermediateBlueprint::strict_cost() const
+{
+    double total = 0.0;
+    for (const Blueprint * child : _children) {
+        total += child->strict_cost();
+    }
+    return total;
+}
+
 IntermediateBlueprint::IntermediateBlueprint() = default;
 
+void
+IntermediateBlueprint::setFilterCache(FilterResultCache &cache, const vespalib::string &key, uint64_t generation)
+{
+    _cached_filter = std::make_unique<CachedFilter>(cache, key, generation);
+}
+
+void
+IntermediateBlueprint::clearFilterCache()
+{
+    _cached_filter.reset();
+}
+
 const Blueprint &
 IntermediateBlueprint::getChild(size_t n) const
 {
@@ -375,6 +461,9 @@ void
 IntermediateBlueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
 {
     StateCache::visitMembers(visitor);
+    if (_cached_filter) {
+        visit(visitor, "filter_cache_key", _cached_filter->key);
+    }
     visit(visitor, "children", _children);
 }
 
@@ -519,6 +608,20 @@ LeafBlueprint::set_tree_size(uint32_t value)
     notifyChange();    
 }
 
+void
+LeafBlueprint::set_cost(double value)
+{
+    _state.cost(value);
+    notifyChange();
+}
+
+void
+LeafBlueprint::set_strict_scan(bool value)
+{
+    _state.strict_scan(value);
+    notifyChange();
+}
+
 //-----------------------------------------------------------------------------
 
 }
@@ -14,6 +14,7 @@ namespace vespalib { class ObjectVisitor; };
 namespace search::queryeval {
 
 class SearchIterator;
+class FilterResultCache;
 
 /**
  * A Blueprint is an intermediate representation of a search. More
@@ -55,6 +56,8 @@ public:
         HitEstimate       _estimate;
         uint32_t          _tree_size;
         bool              _allow_termwise_eval;
+        double            _cost;
+        bool              _strict_scan;
 
     public:
         State(const FieldSpecBaseList &fields_in);
@@ -64,6 +67,8 @@ public:
             std::swap(_estimate, rhs._estimate);
             std::swap(_tree_size, rhs._tree_size);
             std::swap(_allow_termwise_eval, rhs._allow_termwise_eval);
+            std::swap(_cost, rhs._cost);
+            std::swap(_strict_scan, rhs._strict_scan);
         }
 
         bool isTermLike() const { return !_fields.empty(); }
@@ -91,6 +96,14 @@ public:
         uint32_t tree_size() const { return _tree_size; }
         void allow_termwise_eval(bool value) { _allow_termwise_eval = value; }
         bool allow_termwise_eval() const { return _allow_termwise_eval; }
+
+        // relative cost of checking a single document when not strict
+        void cost(double value) { _cost = value; }
+        double cost() const { return _cost; }
+
+        // strict iteration visits all documents, not only the hits
+        void strict_scan(bool value) { _strict_scan = value; }
+        bool strict_scan() const { return _strict_scan; }
     };
 
     // utility that just takes maximum estimate
@@ -165,6 +178,12 @@ public:
 
     double hit_ratio() const { return getState().hit_ratio(_docid_limit); }        
 
+    // Estimated cost per document in the corpus of evaluating this
+    // blueprint as a non-strict or strict iterator. Used to decide
+    // the order and strictness of the children of AND-like nodes.
+    virtual double cost() const { return getState().cost(); }
+    virtual double strict_cost() const;
+
     virtual void fetchPostings(bool strict) = 0;
     virtual void freeze() = 0;
     bool frozen() const { return _frozen; }
@@ -219,7 +238,10 @@ class IntermediateBlueprint : public blueprint::StateCache
 public:
     typedef std::vector<Blueprint*> Children;
 private:
+    struct CachedFilter;
+
     Children _children;
+    std::unique_ptr<CachedFilter> _cached_filter;
     HitEstimate calculateEstimate() const;
     uint32_t calculate_tree_size() const;
     bool infer_allow_termwise_eval() const;
@@ -236,6 +258,8 @@ protected:
     virtual bool isPositive(size_t index) const { (void) index; return true; }
 
     bool should_do_termwise_eval(const UnpackInfo &unpack, double match_limit) const;
+    SearchIteratorUP createCachedFilterSearch(fef::MatchData &md, bool strict) const;
+    SearchIteratorUP createUncachedSearch(fef::MatchData &md, bool strict) const;
 
 public:
     typedef std::vector<size_t> IndexList;
@@ -253,7 +277,19 @@ public:
     IntermediateBlueprint & insertChild(size_t n, Blueprint::UP child);
     IntermediateBlueprint &addChild(Blueprint::UP child);
     Blueprint::UP removeChild(size_t n);
+
+    /**
+     * Let the hits of this subtree be served from the given cache when
+     * no match data is needed from it. The key must identify what the
+     * subtree matches and the generation must change whenever the
+     * searched data does.
+     **/
+    void setFilterCache(FilterResultCache &cache, const vespalib::string &key, uint64_t generation);
+    void clearFilterCache();
+    bool hasFilterCache() const { return bool(_cached_filter); }
     SearchIteratorUP createSearch(fef::MatchData &md, bool strict) const override;
+    double cost() const override;
+    double strict_cost() const override;
 
     virtual HitEstimate combine(const std::vector<HitEstimate> &data) const = 0;
     virtual FieldSpecBaseList exposeFields() const = 0;
@@ -282,6 +318,8 @@ protected:
     void setEstimate(HitEstimate est);
     void set_allow_termwise_eval(bool value);
     void set_tree_size(uint32_t value);
+    void set_cost(double value);
+    void set_strict_scan(bool value);
 
     LeafBlueprint(const FieldSpecBaseList &fields, bool allow_termwise_eval);
 public:
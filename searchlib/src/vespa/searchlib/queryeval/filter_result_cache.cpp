@@ -0,0 +1,142 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_result_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace search::queryeval {
+
+using BitVectorSP = FilterResultCache::BitVectorSP;
+
+namespace {
+
+template <bool IS_STRICT>
+struct CachedResultSearch : public SearchIterator {
+
+    BitVectorSP result;
+
+    CachedResultSearch(BitVectorSP result_in) : result(std::move(result_in)) {}
+
+    Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
+    void initRange(uint32_t beginid, uint32_t endid) override {
+        SearchIterator::initRange(beginid, endid);
+        if (IS_STRICT) {
+            doSeek(beginid);
+        }
+    }
+    void doSeek(uint32_t docid) override {
+        if (__builtin_expect(isAtEnd(docid) || (docid >= result->size()), false)) {
+            setAtEnd();
+        } else if (IS_STRICT) {
+            uint32_t nextid = result->getNextTrueBit(docid);
+            if (__builtin_expect(isAtEnd(nextid), false)) {
+                setAtEnd();
+            } else {
+                setDocId(nextid);
+            }
+        } else if (result->testBit(docid)) {
+            setDocId(docid);
+        }
+    }
+    void doUnpack(uint32_t) override {}
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        visit(visitor, "docid_limit", result->size());
+        visit(visitor, "strict", IS_STRICT);
+    }
+};
+
+size_t calculate_memory_used(const vespalib::string &key, const BitVector &result) {
+    return (key.size() + result.getFileBytes());
+}
+
+} // namespace search::queryeval::<unnamed>
+
+FilterResultCache::FilterResultCache(size_t max_memory)
+    : _mutex(),
+      _max_memory(max_memory),
+      _memory_used(0),
+      _hits(0),
+      _misses(0),
+      _lru(),
+      _entries()
+{
+}
+
+FilterResultCache::~FilterResultCache() = default;
+
+void
+FilterResultCache::remove(const vespalib::string &key)
+{
+    auto pos = _entries.find(key);
+    if (pos != _entries.end()) {
+        LruList::iterator lru_pos = pos->second.lru_pos;
+        _memory_used -= pos->second.memory_used;
+        _entries.erase(pos);
+        _lru.erase(lru_pos); // may own 'key'
+    }
+}
+
+BitVectorSP
+FilterResultCache::lookup(const vespalib::string &key, uint64_t generation, uint32_t docid_limit)
+{
+    LockGuard guard(_mutex);
+    auto pos = _entries.find(key);
+    if (pos != _entries.end()) {
+        Entry &entry = pos->second;
+        if ((entry.generation == generation) && (entry.result->size() == docid_limit)) {
+            _lru.splice(_lru.begin(), _lru, entry.lru_pos);
+            ++_hits;
+            return entry.result;
+        }
+        remove(key); // stale
+    }
+    ++_misses;
+    return BitVectorSP();
+}
+
+void
+FilterResultCache::insert(const vespalib::string &key, uint64_t generation, BitVectorSP result)
+{
+    size_t memory_used = calculate_memory_used(key, *result);
+    LockGuard guard(_mutex);
+    remove(key);
+    if (memory_used > _max_memory) {
+        return;
+    }
+    while ((_memory_used + memory_used) > _max_memory) {
+        remove(_lru.back());
+    }
+    _lru.push_front(key);
+    Entry entry;
+    entry.generation = generation;
+    entry.result = std::move(result);
+    entry.memory_used = memory_used;
+    entry.lru_pos = _lru.begin();
+    _entries.insert(std::make_pair(key, std::move(entry)));
+    _memory_used += memory_used;
+}
+
+FilterResultCache::Stats
+FilterResultCache::get_stats() const
+{
+    LockGuard guard(_mutex);
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.entries = _entries.size();
+    stats.memory_used = _memory_used;
+    return stats;
+}
+
+SearchIterator::UP
+FilterResultCache::create_search(BitVectorSP result, bool strict)
+{
+    if (strict) {
+        return std::make_unique<CachedResultSearch<true>>(std::move(result));
+    } else {
+        return std::make_unique<CachedResultSearch<false>>(std::move(result));
+    }
+}
+
+}
@@ -0,0 +1,92 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace search { class BitVector; }
+
+namespace search::queryeval {
+
+/**
+ * Cache of the hits produced by filter subtrees of queries, shared
+ * by all queries against the same data. Each entry is keyed by a
+ * normalized representation of the subtree and tagged with the
+ * generation of the data it was calculated from and the docid limit
+ * it covers. Entries with a different generation or docid limit are
+ * treated as misses, so feeding to any of the searched fields
+ * invalidates the entries using them. The least recently used
+ * entries are evicted to stay within the memory budget.
+ *
+ * This class is thread-safe.
+ **/
+class FilterResultCache
+{
+public:
+    using BitVectorSP = std::shared_ptr<const BitVector>;
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t entries;
+        size_t memory_used;
+        Stats() : hits(0), misses(0), entries(0), memory_used(0) {}
+    };
+
+private:
+    using LockGuard = std::lock_guard<std::mutex>;
+    using LruList = std::list<vespalib::string>;
+
+    struct Entry {
+        uint64_t          generation;
+        BitVectorSP       result;
+        size_t            memory_used;
+        LruList::iterator lru_pos;
+    };
+
+    using Entries = vespalib::hash_map<vespalib::string, Entry>;
+
+    mutable std::mutex _mutex;
+    size_t             _max_memory;
+    size_t             _memory_used;
+    size_t             _hits;
+    size_t             _misses;
+    LruList            _lru; // most recently used first
+    Entries            _entries;
+
+    void remove(const vespalib::string &key);
+
+public:
+    FilterResultCache(size_t max_memory);
+    ~FilterResultCache();
+
+    size_t max_memory() const { return _max_memory; }
+
+    /**
+     * Look up the hits for the given subtree. Returns an empty
+     * pointer if there is no entry for the given generation and
+     * docid limit.
+     **/
+    BitVectorSP lookup(const vespalib::string &key, uint64_t generation, uint32_t docid_limit);
+
+    /**
+     * Store the hits for the given subtree, replacing any older
+     * entry. Results larger than the memory budget are not stored.
+     **/
+    void insert(const vespalib::string &key, uint64_t generation, BitVectorSP result);
+
+    Stats get_stats() const;
+
+    /**
+     * Create a search iterator over cached hits. The iterator shares
+     * ownership of the hits, making it independent of the cache.
+     **/
+    static SearchIterator::UP create_search(BitVectorSP result, bool strict);
+};
+
+}
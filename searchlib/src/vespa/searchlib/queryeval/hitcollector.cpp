@@ -3,9 +3,122 @@
 #include "hitcollector.h"
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/common/sort.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_set.h>
 
 namespace search::queryeval {
 
+/**
+ * Keeps the best ranked hits while limiting the number of hits kept
+ * for each group. The hits of each group are kept in a separate
+ * min-heap. A global min-heap over all kept hits is used to find the
+ * hit to drop when a hit from a group below its limit arrives. Hits
+ * dropped from a group are removed lazily from the global heap.
+ **/
+class HitCollector::DiversityHeap
+{
+private:
+    struct Entry {
+        Hit      hit;
+        uint64_t group;
+        Entry(const Hit &hit_in, uint64_t group_in) : hit(hit_in), group(group_in) {}
+    };
+    struct EntryComparator {
+        bool operator() (const Entry &lhs, const Entry &rhs) const {
+            return ScoreComparator()(lhs.hit, rhs.hit);
+        }
+    };
+    using Groups = vespalib::hash_map<uint64_t, std::vector<Hit>>;
+
+    std::unique_ptr<DocumentGrouper> _grouper;
+    const uint32_t                   _maxHits;
+    const uint32_t                   _maxHitsPerGroup;
+    uint32_t                         _numHits;
+    Groups                           _groups;
+    std::vector<Entry>               _heap; // may contain hits dropped from their group
+    vespalib::hash_set<uint32_t>     _kept;
+
+    const Entry &worst() {
+        while (_kept.find(_heap.front().hit.first) == _kept.end()) {
+            std::pop_heap(_heap.begin(), _heap.end(), EntryComparator());
+            _heap.pop_back();
+        }
+        return _heap.front();
+    }
+    void rebuildHeap() {
+        _heap.clear();
+        for (const auto &group : _groups) {
+            for (const Hit &hit : group.second) {
+                _heap.emplace_back(hit, group.first);
+            }
+        }
+        std::make_heap(_heap.begin(), _heap.end(), EntryComparator());
+    }
+    void insert(std::vector<Hit> &hits, uint64_t group, const Hit &hit) {
+        hits.push_back(hit);
+        std::push_heap(hits.begin(), hits.end(), ScoreComparator());
+        _kept.insert(hit.first);
+        _heap.emplace_back(hit, group);
+        std::push_heap(_heap.begin(), _heap.end(), EntryComparator());
+        if (_heap.size() >= 2 * _maxHits) {
+            rebuildHeap();
+        }
+    }
+    void dropWorst(std::vector<Hit> &hits) {
+        _kept.erase(hits.front().first);
+        std::pop_heap(hits.begin(), hits.end(), ScoreComparator());
+        hits.pop_back();
+    }
+
+public:
+    DiversityHeap(std::unique_ptr<DocumentGrouper> grouper, uint32_t maxHits, uint32_t maxHitsPerGroup)
+        : _grouper(std::move(grouper)),
+          _maxHits(maxHits),
+          _maxHitsPerGroup(maxHitsPerGroup),
+          _numHits(0),
+          _groups(),
+          _heap(),
+          _kept(maxHits * 2)
+    {
+        _heap.reserve(2 * maxHits);
+    }
+
+    void add(uint32_t docId, feature_t score) {
+        bool full = (_numHits == _maxHits);
+        if (full && !(score > worst().hit.second)) {
+            return;
+        }
+        Hit hit(docId, score);
+        uint64_t group = _grouper->group(docId);
+        auto pos = _groups.find(group);
+        if ((pos != _groups.end()) && (pos->second.size() >= _maxHitsPerGroup)) {
+            if (score > pos->second.front().second) {
+                dropWorst(pos->second);
+                insert(pos->second, group, hit);
+            }
+            return;
+        }
+        if (full) {
+            // the worst hit overall is also the worst hit in its group
+            uint64_t worstGroup = worst().group;
+            auto worstPos = _groups.find(worstGroup);
+            dropWorst(worstPos->second);
+            if (worstPos->second.empty()) {
+                _groups.erase(worstPos);
+            }
+        } else {
+            ++_numHits;
+        }
+        insert(_groups[group], group, hit);
+    }
+
+    void extract(std::vector<Hit> &hits) const {
+        for (const auto &group : _groups) {
+            hits.insert(hits.end(), group.second.begin(), group.second.end());
+        }
+    }
+};
+
 void
 HitCollector::sortHitsByScore(size_t topn)
 {
@@ -52,11 +165,21 @@ HitCollector::HitCollector(uint32_t numDocs,
     if (_maxHitsSize > 0) {
         _collector = std::make_unique<RankedHitCollector>(*this);
     } else {
-        _collector = std::make_unique<DocIdCollector<false>>(*this);
+        _collector = std::make_unique<DocIdCollector<false, false>>(*this);
     }
     _hits.reserve(maxHitsSize);
 }
 
+HitCollector::HitCollector(uint32_t numDocs, uint32_t maxHitsSize,
+                           std::unique_ptr<DocumentGrouper> grouper, uint32_t maxHitsPerGroup)
+    : HitCollector(numDocs, maxHitsSize)
+{
+    if ((_maxHitsSize > 0) && grouper && (maxHitsPerGroup > 0)) {
+        _diversityHeap = std::make_unique<DiversityHeap>(std::move(grouper), _maxHitsSize, maxHitsPerGroup);
+        _collector = std::make_unique<DocIdCollector<true, true>>(*this);
+    }
+}
+
 HitCollector::~HitCollector() = default;
 
 void
@@ -77,11 +200,13 @@ HitCollector::RankedHitCollector::collect(uint32_t docId, feature_t score)
     }
 }
 
-template <bool CollectRankedHit>
+template <bool CollectRankedHit, bool Diversify>
 void
-HitCollector::BitVectorCollector<CollectRankedHit>::collect(uint32_t docId, feature_t score) {
+HitCollector::BitVectorCollector<CollectRankedHit, Diversify>::collect(uint32_t docId, feature_t score) {
     this->_hc._bitVector->setBit(docId);
-    if (CollectRankedHit) {
+    if (Diversify) {
+        this->_hc._diversityHeap->add(docId, score);
+    } else if (CollectRankedHit) {
         this->considerForHitVector(docId, score);
     }
 }
@@ -108,7 +233,7 @@ HitCollector::RankedHitCollector::collectAndChangeCollector(uint32_t docId, feat
             hc._docIdVector.push_back(hc._hits[i].first);
         }
         hc._docIdVector.push_back(docId);
-        newCollector = std::make_unique<DocIdCollector<true>>(hc);
+        newCollector = std::make_unique<DocIdCollector<true, false>>(hc);
     } else {
         // start using bit vector
         hc._bitVector = BitVector::create(hc._numDocs);
@@ -118,7 +243,7 @@ HitCollector::RankedHitCollector::collectAndChangeCollector(uint32_t docId, feat
             hc._bitVector->setBit(hc._hits[i].first);
         }
         hc._bitVector->setBit(docId);
-        newCollector = std::make_unique<BitVectorCollector<true>>(hc);
+        newCollector = std::make_unique<BitVectorCollector<true, false>>(hc);
     }
     // treat hit vector as a heap
     std::make_heap(hc._hits.begin(), hc._hits.end(), ScoreComparator());
@@ -127,11 +252,13 @@ HitCollector::RankedHitCollector::collectAndChangeCollector(uint32_t docId, feat
     hc._collector = std::move(newCollector);
 }
 
-template<bool CollectRankedHit>
+template<bool CollectRankedHit, bool Diversify>
 void
-HitCollector::DocIdCollector<CollectRankedHit>::collect(uint32_t docId, feature_t score)
+HitCollector::DocIdCollector<CollectRankedHit, Diversify>::collect(uint32_t docId, feature_t score)
 {
-    if (CollectRankedHit) {
+    if (Diversify) {
+        this->_hc._diversityHeap->add(docId, score);
+    } else if (CollectRankedHit) {
         this->considerForHitVector(docId, score);
     }
     HitCollector & hc = this->_hc;
@@ -148,9 +275,9 @@ HitCollector::DocIdCollector<CollectRankedHit>::collect(uint32_t docId, feature_
     }
 }
 
-template<bool CollectRankedHit>
+template<bool CollectRankedHit, bool Diversify>
 void
-HitCollector::DocIdCollector<CollectRankedHit>::collectAndChangeCollector(uint32_t docId)
+HitCollector::DocIdCollector<CollectRankedHit, Diversify>::collectAndChangeCollector(uint32_t docId)
 {
     HitCollector & hc = this->_hc;
     // start using bit vector instead of docid array.
@@ -163,12 +290,23 @@ HitCollector::DocIdCollector<CollectRankedHit>::collectAndChangeCollector(uint32
     std::vector<uint32_t> emptyVector;
     emptyVector.swap(hc._docIdVector);
     hc._bitVector->setBit(docId);
-    hc._collector = std::make_unique<BitVectorCollector<CollectRankedHit>>(hc); // note - self-destruct.
+    hc._collector = std::make_unique<BitVectorCollector<CollectRankedHit, Diversify>>(hc); // note - self-destruct.
+}
+
+void
+HitCollector::extractDiversifiedHits()
+{
+    if (_diversityHeap) {
+        _diversityHeap->extract(_hits);
+        _diversityHeap.reset();
+        _hitsSortOrder = SortOrder::NONE;
+    }
 }
 
 SortedHitSequence
 HitCollector::getSortedHitSequence(size_t max_hits)
 {
+    extractDiversifiedHits();
     size_t num_hits = std::min(_hits.size(), max_hits);
     sortHitsByScore(num_hits);
     return SortedHitSequence(&_hits[0], &_scoreOrder[0], num_hits);
@@ -186,8 +324,8 @@ HitCollector::reRank(DocumentScorer &scorer, std::vector<Hit> hits) {
                          -std::numeric_limits<feature_t>::max());
 
     std::sort(hits.begin(), hits.end()); // sort on docId
-    for (auto &hit : hits) {
-        hit.second = scorer.score(hit.first);
+    scorer.scoreHits(hits);
+    for (const auto &hit : hits) {
         finalScores.low = std::min(finalScores.low, hit.second);
         finalScores.high = std::max(finalScores.high, hit.second);
     }
@@ -230,6 +368,7 @@ mergeHitsIntoResultSet(const std::vector<HitCollector::Hit> &hits, ResultSet &re
 std::unique_ptr<ResultSet>
 HitCollector::getResultSet(HitRank default_value)
 {
+    extractDiversifiedHits();
     Scores &initHeapScores = _ranges.first;
     Scores &finalHeapScores = _ranges.second;
     if (initHeapScores.low > finalHeapScores.low) {
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/common/hitrank.h>
 #include <vespa/searchlib/common/resultset.h>
 #include <algorithm>
+#include <memory>
 #include <vector>
 #include <vespa/vespalib/util/sort.h>
 #include <vespa/fastos/dynamiclibrary.h>
@@ -26,6 +27,24 @@ public:
     struct DocumentScorer {
         virtual ~DocumentScorer() {}
         virtual feature_t score(uint32_t docId) = 0;
+        /**
+         * Score all the given hits, which are sorted on docId. The
+         * default implementation scores one hit at a time.
+         */
+        virtual void scoreHits(std::vector<Hit> &hits) {
+            for (auto &hit : hits) {
+                hit.second = score(hit.first);
+            }
+        }
+    };
+
+    /**
+     * Interface used to look up the group of a document when
+     * limiting the number of ranked hits kept per group.
+     */
+    struct DocumentGrouper {
+        virtual ~DocumentGrouper() {}
+        virtual uint64_t group(uint32_t docId) = 0;
     };
 
 private:
@@ -50,6 +69,9 @@ private:
     bool _hasReRanked;
     bool _needReScore;
 
+    class DiversityHeap;
+    std::unique_ptr<DiversityHeap> _diversityHeap;
+
     struct ScoreComparator {
         bool operator() (const Hit & lhs, const Hit & rhs) const {
             if (lhs.second == rhs.second) {
@@ -118,7 +140,7 @@ private:
         bool isRankedHitCollector() const override { return true; }
     };
 
-    template <bool CollectRankedHit>
+    template <bool CollectRankedHit, bool Diversify>
     class DocIdCollector : public CollectorBase {
     public:
         DocIdCollector(HitCollector &hc) : CollectorBase(hc) { }
@@ -127,7 +149,7 @@ private:
         bool isDocIdCollector() const override { return true; }
     };
 
-    template <bool CollectRankedHit>
+    template <bool CollectRankedHit, bool Diversify>
     class BitVectorCollector : public CollectorBase {
     public:
         BitVectorCollector(HitCollector &hc) : CollectorBase(hc) { }
@@ -139,6 +161,7 @@ private:
     }
     VESPA_DLL_LOCAL void sortHitsByScore(size_t topn);
     VESPA_DLL_LOCAL void sortHitsByDocId();
+    VESPA_DLL_LOCAL void extractDiversifiedHits();
 
 public:
     HitCollector(const HitCollector &) = delete;
@@ -153,6 +176,21 @@ public:
      * @param maxHitsSize
      **/
     HitCollector(uint32_t numDocs, uint32_t maxHitsSize);
+
+    /**
+     * Creates a hit collector that stores doc id and rank score for
+     * the n (=maxHitsSize) best hits, keeping at most
+     * maxHitsPerGroup of them for each group given by the document
+     * grouper. Hits dropped by the group limit are still stored as
+     * doc ids.
+     *
+     * @param numDocs
+     * @param maxHitsSize
+     * @param grouper used to look up the group of each ranked hit
+     * @param maxHitsPerGroup
+     **/
+    HitCollector(uint32_t numDocs, uint32_t maxHitsSize,
+                 std::unique_ptr<DocumentGrouper> grouper, uint32_t maxHitsPerGroup);
     ~HitCollector();
 
     /**
@@ -11,6 +11,7 @@
 #include "termwise_blueprint_helper.h"
 #include "isourceselector.h"
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
+#include <limits>
 
 namespace search::queryeval {
 
@@ -68,6 +69,61 @@ void optimize_source_blenders(IntermediateBlueprint &self, size_t begin_idx) {
     }
 }
 
+// fraction of the documents matched by a child, used to estimate
+// how many documents are passed on to the children after it
+double pass_ratio(const Blueprint &child) {
+    if (child.getState().estimate().empty) {
+        return 0.0;
+    }
+    if (child.get_docid_limit() == 0) {
+        return 1.0;
+    }
+    return child.hit_ratio();
+}
+
+// cost of checking a document against all children in the given
+// order, where each child only sees documents matched by the ones
+// before it
+template <typename Children>
+double and_cost(const Children &children, size_t skip_idx) {
+    double total = 0.0;
+    double pass = 1.0;
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (i != skip_idx) {
+            total += pass * children[i]->cost();
+            pass *= pass_ratio(*children[i]);
+        }
+    }
+    return total;
+}
+
+// cost of a strict AND where the child at index 'strict_idx' is
+// strict and the other children are checked in the given order
+template <typename Children>
+double strict_and_cost(const Children &children, size_t strict_idx) {
+    const Blueprint &strict_child = *children[strict_idx];
+    return strict_child.strict_cost() + pass_ratio(strict_child) * and_cost(children, strict_idx);
+}
+
+// a non-strict AND child is better placed early when it is cheap
+// and likely to reject documents
+struct LessCostPerRejected {
+    static double rank(const Blueprint &child) {
+        double reject = (1.0 - pass_ratio(child));
+        if (reject <= 0.0) {
+            return std::numeric_limits<double>::max();
+        }
+        return child.cost() / reject;
+    }
+    bool operator () (Blueprint * const &a, Blueprint * const &b) const {
+        return (rank(*a) < rank(*b));
+    }
+};
+
+// only let the cost model override the estimate based strict child
+// when the difference is large enough to be trusted
+constexpr double strict_cost_margin = 0.9;
+
 } // namespace search::queryeval::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -120,6 +176,26 @@ AndNotBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+double
+AndNotBlueprint::cost() const
+{
+    if (childCnt() == 0) {
+        return IntermediateBlueprint::cost();
+    }
+    const Blueprint &positive = getChild(0);
+    return positive.cost() + pass_ratio(positive) * (IntermediateBlueprint::cost() - positive.cost());
+}
+
+double
+AndNotBlueprint::strict_cost() const
+{
+    if (childCnt() == 0) {
+        return IntermediateBlueprint::strict_cost();
+    }
+    const Blueprint &positive = getChild(0);
+    return positive.strict_cost() + pass_ratio(positive) * (IntermediateBlueprint::cost() - positive.cost());
+}
+
 void
 AndNotBlueprint::sort(std::vector<Blueprint*> &children) const
 {
@@ -194,10 +270,50 @@ AndBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+double
+AndBlueprint::cost() const
+{
+    std::vector<const Blueprint *> children;
+    for (size_t i = 0; i < childCnt(); ++i) {
+        children.push_back(&getChild(i));
+    }
+    return and_cost(children, children.size());
+}
+
+double
+AndBlueprint::strict_cost() const
+{
+    if (childCnt() == 0) {
+        return IntermediateBlueprint::strict_cost();
+    }
+    std::vector<const Blueprint *> children;
+    for (size_t i = 0; i < childCnt(); ++i) {
+        children.push_back(&getChild(i));
+    }
+    return strict_and_cost(children, 0);
+}
+
 void
 AndBlueprint::sort(std::vector<Blueprint*> &children) const
 {
     std::sort(children.begin(), children.end(), LessEstimate());
+    if ((children.size() < 2) || (get_docid_limit() == 0)) {
+        return;
+    }
+    // non-strict children are checked in order of cost per rejected
+    // document; this keeps the estimate order when all costs are equal
+    std::stable_sort(children.begin(), children.end(), LessCostPerRejected());
+    // the first child is strict; pick the one giving the cheapest plan
+    size_t best_idx = 0;
+    double best_cost = strict_and_cost(children, 0);
+    for (size_t i = 1; i < children.size(); ++i) {
+        double cost = strict_and_cost(children, i);
+        if (cost < (best_cost * strict_cost_margin)) {
+            best_idx = i;
+            best_cost = cost;
+        }
+    }
+    std::rotate(children.begin(), children.begin() + best_idx, children.begin() + best_idx + 1);
 }
 
 bool
@@ -468,6 +584,18 @@ RankBlueprint::get_replacement()
     return Blueprint::UP();
 }
 
+double
+RankBlueprint::cost() const
+{
+    return (childCnt() == 0) ? IntermediateBlueprint::cost() : getChild(0).cost();
+}
+
+double
+RankBlueprint::strict_cost() const
+{
+    return (childCnt() == 0) ? IntermediateBlueprint::strict_cost() : getChild(0).strict_cost();
+}
+
 void
 RankBlueprint::sort(std::vector<Blueprint*> &children) const
 {
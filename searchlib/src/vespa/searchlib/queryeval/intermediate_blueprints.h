@@ -19,6 +19,8 @@ public:
     FieldSpecBaseList exposeFields() const override;
     void optimize_self() override;
     Blueprint::UP get_replacement() override;
+    double cost() const override;
+    double strict_cost() const override;
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
@@ -38,6 +40,8 @@ public:
     FieldSpecBaseList exposeFields() const override;
     void optimize_self() override;
     Blueprint::UP get_replacement() override;
+    double cost() const override;
+    double strict_cost() const override;
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
@@ -138,6 +142,8 @@ public:
     FieldSpecBaseList exposeFields() const override;
     void optimize_self() override;
     Blueprint::UP get_replacement() override;
+    double cost() const override;
+    double strict_cost() const override;
     void sort(std::vector<Blueprint*> &children) const override;
     bool inheritStrict(size_t i) const override;
     SearchIterator::UP
@@ -4,6 +4,7 @@
 
 #include "searchiterator.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <limits>
 
 namespace search::fef { class MatchData; }
 
@@ -47,6 +48,17 @@ public:
         _children[ref]->doUnpack(docid);
     }
 
+    // no block level information is available for generic children
+    static constexpr bool has_block_max = false;
+
+    int32_t get_block_max_weight(uint32_t) const {
+        return std::numeric_limits<int32_t>::max();
+    }
+
+    uint32_t get_block_end(uint32_t ref) const {
+        return get_docid(ref);
+    }
+
     size_t size() const {
         return _children.size();
     }
@@ -1,8 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "nearsearch.h"
+#include "packed_positions.h"
 #include <vespa/vespalib/objects/visit.h>
-#include <vespa/vespalib/util/priority_queue.h>
-#include <limits>
+#include <algorithm>
 #include <set>
 
 #include <vespa/log/log.h>
@@ -14,7 +14,6 @@ namespace queryeval {
 namespace {
 
 using search::fef::TermFieldMatchDataArray;
-using search::fef::TermFieldMatchDataPositionKey;
 
 template<typename T>
 void setup_fields(uint32_t window, std::vector<T> &matchers, const TermFieldMatchDataArray &in) {
@@ -133,82 +132,61 @@ NearSearch::NearSearch(const Children & terms,
     setup_fields(window, _matchers, data);
 }
 
-namespace {
-
-struct PosIter {
-    search::fef::TermFieldMatchData::PositionsIterator curPos;
-    search::fef::TermFieldMatchData::PositionsIterator endPos;
-
-    bool operator< (const PosIter &other) const {
-        // assumes none is at end
-        TermFieldMatchDataPositionKey mykey = *curPos;
-        TermFieldMatchDataPositionKey otherkey = *other.curPos;
-        return mykey < otherkey;
-    }
-};
-
-struct Iterators
-{
-    vespalib::PriorityQueue<PosIter> _queue;
-    TermFieldMatchDataPositionKey _maxOcc;
-
-    void update(TermFieldMatchDataPositionKey occ)
-    {
-        if (_queue.size() == 1 || _maxOcc < occ) { _maxOcc = occ; }
-    }
-
-    void add(const search::fef::TermFieldMatchData *term)
-    {
-        PosIter iter;
-        iter.curPos = term->begin();
-        iter.endPos = term->end();
-        LOG_ASSERT(iter.curPos != iter.endPos);
-        _queue.push(iter);
-        update(*iter.curPos);
-    }
-
-    bool match(uint32_t window) {
-        for (;;) {
-            PosIter &front = _queue.front();
-            TermFieldMatchDataPositionKey lastAllowed = *front.curPos;
-            lastAllowed.setPosition(front.curPos->getPosition() + window);
-
-            if (!(lastAllowed < _maxOcc)) {
-                return true;
-            }
-            do {
-                ++front.curPos;
-                if (front.curPos == front.endPos) {
-                    return false;
-                }
-                lastAllowed = *front.curPos;
-                lastAllowed.setPosition(front.curPos->getPosition() + window);
-            } while (lastAllowed < _maxOcc);
-
-            update(*front.curPos);
-            _queue.adjust();
-        }
-    }
-};
-
-} // namespace <unnamed>
-
 bool
-NearSearch::Matcher::match(uint32_t docId)
+NearSearchBase::MatcherBase::packPositions(uint32_t docId)
 {
-    Iterators pos;
+    _keys.clear();
+    _offsets.clear();
+    _pos.clear();
     for (uint32_t i = 0, len = inputs().size(); i < len; ++i) {
         const search::fef::TermFieldMatchData *term = inputs()[i];
         if (term->getDocId() != docId || term->begin() == term->end()) {
             LOG(debug, "No occurrences found for term %d.", i);
             return false;
         }
-        LOG(debug, "Got positions iterator for term %d.", i);
-        pos.add(term);
+        _offsets.push_back(_keys.size());
+        _pos.push_back(_keys.size());
+        PackedPositions::append(*term, 0, _keys);
     }
+    _offsets.push_back(_keys.size());
+    return true;
+}
 
-    // Look for matching window.
-    return pos.match(window());
+bool
+NearSearch::Matcher::match(uint32_t docId)
+{
+    if (!packPositions(docId)) {
+        return false;
+    }
+    uint32_t numTerms = _pos.size();
+    if (numTerms == 0) {
+        return true;
+    }
+    const uint64_t *keys = _keys.data();
+    uint64_t maxKey = 0;
+    for (uint32_t i = 0; i < numTerms; ++i) {
+        maxKey = std::max(maxKey, keys[_pos[i]]);
+    }
+    // Slide the window over the positions, always moving the term at
+    // the earliest position, until all terms are within the window.
+    for (;;) {
+        uint32_t first = 0;
+        for (uint32_t i = 1; i < numTerms; ++i) {
+            if (keys[_pos[i]] < keys[_pos[first]]) {
+                first = i;
+            }
+        }
+        uint32_t &pos = _pos[first];
+        if (!(PackedPositions::window_end(keys[pos], window()) < maxKey)) {
+            return true;
+        }
+        do {
+            if (++pos == _offsets[first + 1]) {
+                return false;
+            }
+        } while (PackedPositions::window_end(keys[pos], window()) < maxKey);
+        maxKey = std::max(maxKey, keys[pos]);
+    }
 }
 
 bool
@@ -237,52 +215,43 @@ ONearSearch::ONearSearch(const Children & terms,
 bool
 ONearSearch::Matcher::match(uint32_t docId)
 {
-    uint32_t numTerms = inputs().size();
-    PositionsIteratorList pos;
-    for (uint32_t i = 0; i < numTerms; ++i) {
-        const search::fef::TermFieldMatchData *term = inputs()[i];
-        if (term->getDocId() != docId || term->begin() == term->end()) {
-            LOG(debug, "No occurrences found for term %d.", i);
-            return false;
-        }
-        LOG(debug, "Got positions iterator for term %d.", i);
-        pos.push_back(term->begin());
+    if (!packPositions(docId)) {
+        return false;
     }
+    uint32_t numTerms = _pos.size();
     if (numTerms < 2) return true; // 1 term is always near itself
 
-    int32_t remain = window();
-
-    TermFieldMatchDataPositionKey prevTermPos;
-    TermFieldMatchDataPositionKey curTermPos;
-    TermFieldMatchDataPositionKey lastAllowed;
+    const uint64_t *keys = _keys.data();
+    uint64_t curTermPos = 0;
 
     // Look for match for every occurrence of the first term.
-    for ( ; pos[0] != inputs()[0]->end(); ++pos[0]) {
-        TermFieldMatchDataPositionKey firstTermPos = *pos[0];
-        lastAllowed = firstTermPos;
-        lastAllowed.setPosition(firstTermPos.getPosition() + remain);
+    for (uint32_t &first = _pos[0]; first < _offsets[1]; ++first) {
+        uint64_t firstTermPos = keys[first];
+        uint64_t lastAllowed = PackedPositions::window_end(firstTermPos, window());
         if (lastAllowed < curTermPos) {
             // if we already know that we must seek onwards:
             continue;
         }
-        prevTermPos = firstTermPos;
+        uint64_t prevTermPos = firstTermPos;
         LOG(spam, "Looking for match in window [%d, %d].",
-            firstTermPos.getPosition(), lastAllowed.getPosition());
+            PackedPositions::position(firstTermPos), PackedPositions::position(lastAllowed));
         for (uint32_t i = 1; i < numTerms; ++i) {
-            LOG(spam, "Forwarding iterator for term %d beyond %d.", i, prevTermPos.getPosition());
-            while (pos[i] != inputs()[i]->end() && !(prevTermPos < *pos[i])) {
-                ++pos[i];
+            LOG(spam, "Forwarding iterator for term %d beyond %d.", i, PackedPositions::position(prevTermPos));
+            uint32_t &pos = _pos[i];
+            uint32_t end = _offsets[i + 1];
+            while (pos < end && !(prevTermPos < keys[pos])) {
+                ++pos;
             }
-            if (pos[i] == inputs()[i]->end()) {
+            if (pos == end) {
                 LOG(debug, "Reached end of occurrences for term %d without matching ONEAR.", i);
                 return false;
             }
-            curTermPos = *pos[i];
+            curTermPos = keys[pos];
             if (lastAllowed < curTermPos) {
                 // outside window
                 break;
             }
-            LOG(spam, "Current position for term %d is %d.", i, curTermPos.getPosition());
+            LOG(spam, "Current position for term %d is %d.", i, PackedPositions::position(curTermPos));
             if (i + 1 == numTerms) {
                 LOG(debug, "ONEAR match found for document %d.", docId);
                 // OK for all terms
@@ -26,12 +26,26 @@ protected:
         uint32_t                _window;
         TermFieldMatchDataArray _inputs;
     protected:
+        // Positions of all terms packed into a single array, reused for each document.
+        std::vector<uint64_t>   _keys;
+        std::vector<uint32_t>   _offsets; // term i has keys [_offsets[i], _offsets[i + 1])
+        std::vector<uint32_t>   _pos;     // current key for each term
+
         uint32_t window() const { return _window; }
         const TermFieldMatchDataArray &inputs() const { return _inputs; }
+
+        /**
+         * Pack the positions of all terms in the given document.
+         * Returns false if any term has no occurrences in it.
+         **/
+        bool packPositions(uint32_t docId);
     public:
         MatcherBase(uint32_t win, uint32_t fieldId, const TermFieldMatchDataArray &in)
             : _window(win),
-              _inputs()
+              _inputs(),
+              _keys(),
+              _offsets(),
+              _pos()
         {
             for (size_t i = 0; i < in.size(); ++i) {
                 if (in[i]->getFieldId() == fieldId) {
@@ -41,11 +55,6 @@ protected:
         }
     };
 
-    /**
-     * Typedef the list of positions iterators because it takes far too much space to write out :-)
-     */
-    typedef std::vector<search::fef::TermFieldMatchData::PositionsIterator> PositionsIteratorList;
-
     /**
      * Returns whether or not given document matches. This should only be called when all child terms are all
      * at the same document.
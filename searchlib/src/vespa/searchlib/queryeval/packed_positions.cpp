@@ -0,0 +1,58 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "packed_positions.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+
+namespace search::queryeval {
+
+namespace {
+
+// number of keys compared at once when skipping ahead in intersect
+constexpr size_t BLOCK_SIZE = 8;
+
+} // namespace search::queryeval::<unnamed>
+
+void
+PackedPositions::append(const fef::TermFieldMatchData &tfmd, uint32_t offset, std::vector<uint64_t> &keys)
+{
+    keys.reserve(keys.size() + tfmd.size());
+    for (auto it = tfmd.begin(); it != tfmd.end(); ++it) {
+        if (it->getPosition() >= offset) {
+            keys.push_back(make_key(it->getElementId(), it->getPosition() - offset));
+        }
+    }
+}
+
+void
+PackedPositions::intersect(std::vector<uint64_t> &keys, const std::vector<uint64_t> &other)
+{
+    const uint64_t *pos = other.data();
+    const uint64_t *end = pos + other.size();
+    size_t dst = 0;
+    for (uint64_t key: keys) {
+        while ((pos + BLOCK_SIZE <= end) && (pos[BLOCK_SIZE - 1] < key)) {
+            pos += BLOCK_SIZE;
+        }
+        if (pos + BLOCK_SIZE <= end) {
+            // branch-free count of smaller keys within the block
+            size_t skip = 0;
+            for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                skip += (pos[i] < key) ? 1 : 0;
+            }
+            pos += skip;
+        } else {
+            while ((pos < end) && (*pos < key)) {
+                ++pos;
+            }
+        }
+        if (pos == end) {
+            break;
+        }
+        if (*pos == key) {
+            keys[dst++] = key;
+        }
+    }
+    keys.resize(dst);
+}
+
+}
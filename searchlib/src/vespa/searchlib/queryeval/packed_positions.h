@@ -0,0 +1,51 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace search::fef { class TermFieldMatchData; }
+
+namespace search::queryeval {
+
+/**
+ * Positions of terms packed into contiguous arrays of 64-bit keys,
+ * with the element id in the upper and the position within the
+ * element in the lower 32 bits. Keys sort in the same order as the
+ * positions in term field match data, so comparing two positions is
+ * a single integer compare. Position constraints for phrase, near
+ * and onear are checked on these arrays with simple loops that the
+ * compiler is able to vectorize.
+ **/
+struct PackedPositions {
+    static uint64_t make_key(uint32_t element_id, uint32_t position) {
+        return ((uint64_t(element_id) << 32) | position);
+    }
+    static uint32_t element_id(uint64_t key) { return (key >> 32); }
+    static uint32_t position(uint64_t key) { return (key & 0xffffffff); }
+
+    /**
+     * The last key within the given window after the given key,
+     * staying within the same element.
+     **/
+    static uint64_t window_end(uint64_t key, uint32_t window) {
+        return make_key(element_id(key), position(key) + window);
+    }
+
+    /**
+     * Append the keys of all positions of a term, moved 'offset'
+     * positions towards the start of their element. Positions less
+     * than 'offset' are skipped. This maps the positions of the term
+     * at index 'offset' in a phrase to the start of the phrase.
+     **/
+    static void append(const fef::TermFieldMatchData &tfmd, uint32_t offset, std::vector<uint64_t> &keys);
+
+    /**
+     * Remove all keys in 'keys' not found in 'other'. Both arrays
+     * must be sorted.
+     **/
+    static void intersect(std::vector<uint64_t> &keys, const std::vector<uint64_t> &other);
+};
+
+}
@@ -1,15 +1,12 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "simple_phrase_search.h"
+#include "packed_positions.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/vespalib/objects/visit.h>
 #include <algorithm>
-#include <functional>
 
 using search::fef::TermFieldMatchData;
-using std::unique_ptr;
-using std::mem_fun_ref;
-using std::transform;
 using std::vector;
 using vespalib::ObjectVisitor;
 
@@ -17,106 +14,6 @@ namespace search {
 namespace queryeval {
 
 namespace {
-// Helper class
-class PhraseMatcher {
-    const fef::TermFieldMatchDataArray &_tmds;
-    const vector<uint32_t> &_eval_order;
-    vector<TermFieldMatchData::PositionsIterator> &_iterators;
-    uint32_t _element_id;
-    uint32_t _position;
-
-    TermFieldMatchData::PositionsIterator &iterator(uint32_t word_index)
-    { return _iterators[word_index]; }
-
-    TermFieldMatchData::PositionsIterator end(uint32_t word_index)
-    { return _tmds[word_index]->end(); }
-
-    uint32_t elementId(uint32_t word_index)
-    { return iterator(word_index)->getElementId(); }
-
-    uint32_t position(uint32_t word_index)
-    { return iterator(word_index)->getPosition(); }
-
-    void iterateToElement(uint32_t word_index) {
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) < _element_id) {
-            ++iterator(word_index);
-        }
-    }
-
-    template <typename FwdIt>
-    bool match(FwdIt first, FwdIt last) {
-        if (first == last) {
-            return true;
-        }
-        uint32_t word_index = *first;
-
-        iterateToElement(word_index);
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) == _element_id) {
-            if (position(word_index) == _position + word_index) {
-                return match(++first, last);
-            } else if (position(word_index) > _position + word_index) {
-                return false;
-            }
-            ++iterator(word_index);
-        }
-        return false;
-    }
-
-    bool match() {
-        _element_id = elementId(_eval_order[0]);
-        if (position(_eval_order[0]) < _eval_order[0]) {
-            // this position too early in element to allow match of other phrase terms
-            return false;
-        }
-        _position = position(_eval_order[0]) - _eval_order[0];
-        return match(++_eval_order.begin(), _eval_order.end());
-    }
-
-public:
-    PhraseMatcher(const fef::TermFieldMatchDataArray &tmds,
-                  const vector<uint32_t> &eval_order,
-                  vector<TermFieldMatchData::PositionsIterator> &iterators)
-        : _tmds(tmds),
-          _eval_order(eval_order),
-          _iterators(iterators)
-    {
-        for (size_t i = 0; i < _tmds.size(); ++i) {
-            _iterators[i] = _tmds[i]->begin();
-        }
-    }
-
-    bool hasMatch() {
-        if (_tmds.size() == 1) {
-            return true;
-        }
-
-        while (iterator(_eval_order[0]) != end(_eval_order[0])) {
-            if (match()) {
-                return true;
-            }
-            ++iterator(_eval_order[0]);
-        }
-        return false;
-    }
-
-    void fillPositions(TermFieldMatchData &tmd) {
-        if (_tmds.size() == 1) {
-            for (TermFieldMatchData::PositionsIterator
-                     it = _tmds[0]->begin(); it != _tmds[0]->end(); ++it) {
-                tmd.appendPosition(*it);
-            }
-        } else {
-            while (iterator(_eval_order[0]) != end(_eval_order[0])) {
-                if (match()) {
-                    tmd.appendPosition(*iterator(0));
-                }
-                ++iterator(_eval_order[0]);
-            }
-        }
-    }
-};
 
 bool allTermsHaveMatch(const SimplePhraseSearch::Children &terms,
                        const vector<uint32_t> &eval_order, uint32_t doc_id) {
@@ -129,13 +26,30 @@ bool allTermsHaveMatch(const SimplePhraseSearch::Children &terms,
 }
 }  // namespace
 
+/**
+ * Calculate the start positions of all occurrences of the phrase, by
+ * mapping the positions of each term to where the phrase would start
+ * and intersecting them, starting with the term with fewest hits.
+ * Returns true if there is at least one occurrence.
+ **/
+bool SimplePhraseSearch::matchPositions() {
+    _phrase_starts.clear();
+    PackedPositions::append(*_childMatch[_eval_order[0]], _eval_order[0], _phrase_starts);
+    for (size_t i = 1; (i < _eval_order.size()) && !_phrase_starts.empty(); ++i) {
+        _term_starts.clear();
+        PackedPositions::append(*_childMatch[_eval_order[i]], _eval_order[i], _term_starts);
+        PackedPositions::intersect(_phrase_starts, _term_starts);
+    }
+    return !_phrase_starts.empty();
+}
+
 void SimplePhraseSearch::phraseSeek(uint32_t doc_id) {
     if (allTermsHaveMatch(getChildren(), _eval_order, doc_id)) {
         if ((_doom != nullptr) && _doom->doom()) {
             setAtEnd();
         } else {
             AndSearch::doUnpack(doc_id);
-            if (PhraseMatcher(_childMatch, _eval_order, _iterators).hasMatch()) {
+            if ((_childMatch.size() == 1) || matchPositions()) {
                 setDocId(doc_id);
             }
         }
@@ -155,7 +69,8 @@ SimplePhraseSearch::SimplePhraseSearch(const Children &children,
       _tmd(tmd),
       _doom(nullptr),
       _strict(strict),
-      _iterators(children.size())
+      _phrase_starts(),
+      _term_starts()
 {
     assert(!children.empty());
     assert(children.size() == _childMatch.size());
@@ -185,7 +100,26 @@ void SimplePhraseSearch::doUnpack(uint32_t doc_id) {
     // All children has already been unpacked before this call is made.
 
     _tmd.reset(doc_id);
-    PhraseMatcher(_childMatch, _eval_order, _iterators).fillPositions(_tmd);
+    const TermFieldMatchData &first = *_childMatch[0];
+    if (_childMatch.size() == 1) {
+        for (auto it = first.begin(); it != first.end(); ++it) {
+            _tmd.appendPosition(*it);
+        }
+    } else if (matchPositions()) {
+        // phrase occurrences are reported at the positions of the first term
+        auto it = first.begin();
+        for (uint64_t start: _phrase_starts) {
+            while ((it != first.end()) &&
+                   (PackedPositions::make_key(it->getElementId(), it->getPosition()) < start))
+            {
+                ++it;
+            }
+            if (it == first.end()) {
+                break;
+            }
+            _tmd.appendPosition(*it);
+        }
+    }
 }
 
 void SimplePhraseSearch::visitMembers(ObjectVisitor &visitor) const {
@@ -26,10 +26,11 @@ class SimplePhraseSearch : public AndSearch
     const vespalib::Doom        *_doom;
     bool                         _strict;
 
-    typedef fef::TermFieldMatchData::PositionsIterator It;
-    // Reuse this vector instead of allocating a new one when needed.
-    std::vector<It> _iterators;
+    // Reuse these vectors instead of allocating new ones for each document.
+    std::vector<uint64_t>        _phrase_starts;
+    std::vector<uint64_t>        _term_starts;
 
+    bool matchPositions();
     void phraseSeek(uint32_t doc_id);
 
 public:
@@ -7,6 +7,19 @@
 namespace search {
 namespace queryeval {
 
+namespace {
+
+// Bounds for the number of docids evaluated termwise at a time. The
+// lower bound keeps the per-window overhead small for dense results,
+// the upper bound limits the size of the bitvector fragment.
+constexpr uint32_t MIN_WINDOW_SIZE = (1u << 16);
+constexpr uint32_t MAX_WINDOW_SIZE = (1u << 20);
+
+// The number of hits we aim to collect in each window
+constexpr uint32_t TARGET_WINDOW_HITS = (1u << 12);
+
+}
+
 template <bool IS_STRICT>
 struct TermwiseSearch : public SearchIterator {
 
@@ -14,22 +27,58 @@ struct TermwiseSearch : public SearchIterator {
     BitVector::UP      result;
     uint32_t           my_beginid;
     uint32_t           my_first_hit;
+    uint32_t           window_begin;
+    uint32_t           window_end;
+    uint32_t           window_size;
+    uint32_t           window_hits;
 
     bool same_range(uint32_t beginid, uint32_t endid) const {
         return ((beginid == my_beginid) && endid == getEndId());
     }
 
+    // Select the size of the next window based on the hit density of
+    // the previous one, aiming for a fixed number of hits per window.
+    void adapt_window_size() {
+        uint64_t wanted = MAX_WINDOW_SIZE;
+        if (window_hits > 0) {
+            wanted = (uint64_t(TARGET_WINDOW_HITS) * (window_end - window_begin)) / window_hits;
+        }
+        window_size = std::max(uint64_t(MIN_WINDOW_SIZE), std::min(wanted, uint64_t(MAX_WINDOW_SIZE)));
+    }
+
+    // Evaluate the search termwise for the next window starting at
+    // 'beginid'. Returns the docid of the search after its range was
+    // initialized if it is inside the window, otherwise 0.
+    uint32_t load_window(uint32_t beginid) {
+        window_begin = beginid;
+        window_end = ((getEndId() - beginid) > window_size) ? (beginid + window_size) : getEndId();
+        search->initRange(window_begin, window_end);
+        uint32_t first_docid = (search->getDocId() < window_end) ? search->getDocId() : 0;
+        result = search->get_hits(window_begin);
+        window_hits = result->countTrueBits();
+        adapt_window_size();
+        return first_docid;
+    }
+
+    // Find the first docid at or after 'beginid' that may be a hit
+    // by letting the (strict) search skip ahead over the full range.
+    uint32_t skip_to_next_hit(uint32_t beginid) {
+        search->initRange(beginid, getEndId());
+        search->seek(beginid);
+        return search->getDocId();
+    }
+
     TermwiseSearch(SearchIterator::UP search_in)
-        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0) {}
+        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0),
+          window_begin(0), window_end(0), window_size(MIN_WINDOW_SIZE), window_hits(0) {}
 
     Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
     void initRange(uint32_t beginid, uint32_t endid) override {
-        if (!same_range(beginid, endid)) {
+        if (!same_range(beginid, endid) || (window_begin != beginid)) {
             my_beginid = beginid;
             SearchIterator::initRange(beginid, endid);
-            search->initRange(beginid, endid);
-            my_first_hit = std::max(getDocId(), search->getDocId());
-            result = search->get_hits(beginid);
+            window_size = MIN_WINDOW_SIZE;
+            my_first_hit = std::max(getDocId(), load_window(beginid));
         }
         setDocId(my_first_hit);
     }
@@ -37,14 +86,34 @@ struct TermwiseSearch : public SearchIterator {
         if (__builtin_expect(isAtEnd(docid), false)) {
             setAtEnd();
         } else if (IS_STRICT) {
+            if (docid >= window_end) {
+                load_window(docid);
+            }
             uint32_t nextid = result->getNextTrueBit(docid);
-            if (__builtin_expect(isAtEnd(nextid), false)) {
-                setAtEnd();
-            } else {
-                setDocId(nextid);
+            while (nextid >= window_end) {
+                if (isAtEnd(window_end)) {
+                    setAtEnd();
+                    return;
+                }
+                uint32_t beginid = window_end;
+                if ((window_hits == 0) && (search->is_strict() == Trinary::True)) {
+                    beginid = skip_to_next_hit(beginid);
+                    if (isAtEnd(beginid)) {
+                        setAtEnd();
+                        return;
+                    }
+                }
+                load_window(beginid);
+                nextid = result->getNextTrueBit(beginid);
+            }
+            setDocId(nextid);
+        } else {
+            if (docid >= window_end) {
+                load_window(docid);
+            }
+            if (result->testBit(docid)) {
+                setDocId(docid);
             }
-        } else if (result->testBit(docid)) {
-            setDocId(docid);
         }
     }
     void doUnpack(uint32_t) override {}
@@ -9,9 +9,14 @@ namespace queryeval {
 
 /**
  * Creates a termwise wrapper for the given search. The wrapper will
- * perform termwise evaluation of the underlying search when the
- * initRange function is called. All hits for the active range are
- * stored in a bitvector fragment in the wrapper. The wrapper will act
+ * perform termwise evaluation of the underlying search one window of
+ * docids at a time, starting when the initRange function is
+ * called. The hits for the current window are stored in a bitvector
+ * fragment in the wrapper. The size of the next window is adapted to
+ * the hit density observed in the previous one, and a strict wrapper
+ * lets the underlying search skip ahead to its next hit after an
+ * empty window. This avoids allocating a bitvector covering the
+ * whole active range for large docid spaces. The wrapper will act
  * as a normal iterator to be used for parallel query evaluation. Note
  * that no match data will be available for the hits returned by the
  * wrapper. Termwise evaluation should only ever be used for parts of
@@ -44,7 +44,12 @@ private:
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+            docid_t skip_to;
+            if (VectorizedTerms::has_block_max &&
+                _algo.check_block_max(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold), skip_to))
+            {
+                _algo.set_candidate(_terms, _heaps, skip_to);
+            } else if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
             } else {
@@ -58,6 +63,12 @@ private:
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
             if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+                docid_t skip_to;
+                if (VectorizedTerms::has_block_max &&
+                    _algo.check_block_max(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold), skip_to))
+                {
+                    return;
+                }
                 if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                     setDocId(_algo.get_candidate());
                 }
@@ -169,6 +169,7 @@ public:
     const score_t *maxScore() const { return &(_maxScore[0]); }
 
     docid_t &docId(ref_t ref) { return _docId[ref]; }
+    docid_t docId(ref_t ref) const { return _docId[ref]; }
     int32_t weight(ref_t ref) const { return _weight[ref]; }
     score_t maxScore(ref_t ref) const { return _maxScore[ref]; }
 
@@ -177,6 +178,10 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
+
+    static constexpr bool has_block_max = IteratorPack::has_block_max;
+    int32_t get_block_max_weight(uint16_t ref) const { return _iteratorPack.get_block_max_weight(ref); }
+    uint32_t get_block_end(uint16_t ref) const { return _iteratorPack.get_block_end(ref); }
     
     vespalib::string stringify_docid() const;
 };
@@ -445,6 +450,15 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    // max score for the posting list block the term is positioned in
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(const VectorizedTerms &terms, ref_t ref) {
+        if (terms.weight(ref) < 0) {
+            return terms.maxScore(ref);
+        }
+        return std::min(terms.maxScore(ref), terms.weight(ref) * (score_t)terms.get_block_max_weight(ref));
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -616,6 +630,36 @@ public:
         return true;
     }
 
+    /**
+     * Block-max check of the current candidate. Present terms are
+     * bounded by the max score of the posting list block they are
+     * positioned in, while past terms use their global max score. If
+     * this bound is not above the threshold, no document before the
+     * end of the first ending present block (or the next future term)
+     * can be a hit either. In that case, the first document that may
+     * be a hit is returned in 'skip_to' and true is returned.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max(const VectorizedTerms &terms, const Heaps &heaps, const Scorer &,
+                         AboveThreshold &&aboveThreshold, docid_t &skip_to)
+    {
+        score_t bound = (_maxUpperBound - _upperBound);
+        docid_t block_end = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            bound += Scorer::calculate_block_max_score(terms, *ref);
+            block_end = std::min(block_end, terms.get_block_end(*ref));
+        }
+        if (aboveThreshold(bound)) {
+            return false;
+        }
+        skip_to = (block_end == search::endDocId) ? block_end : (block_end + 1);
+        if (heaps.has_future()) {
+            skip_to = std::min(skip_to, terms.docId(heaps.future()));
+        }
+        return true;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
@@ -40,6 +40,7 @@ WeightedSetTermBlueprint::addTerm(Blueprint::UP term, int32_t weight)
     _weights.push_back(weight);
     _terms.push_back(term.get());
     term.release();
+    set_cost(_terms.size());
 }
 
 
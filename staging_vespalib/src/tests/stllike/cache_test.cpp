@@ -4,6 +4,7 @@
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <map>
+#include <set>
 
 using namespace vespalib;
 
@@ -136,4 +137,87 @@ TEST("testThatMultipleRemoveOnOverflowIsFine") {
     EXPECT_EQUAL(2924u, cache.sizeBytes());
 }
 
+TEST("require that objects read more than once survive a scan when protected segment is enabled") {
+    B m;
+    for (uint32_t i(0); i < 100; i++) {
+        m[i] = "a";
+    }
+    cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, 810);
+    cache.setProtectedCapacityBytes(405);
+    for (uint32_t i(0); i < 4; i++) {
+        cache.read(i);
+        cache.read(i);
+    }
+    EXPECT_EQUAL(4u, cache.size());
+    EXPECT_EQUAL(324u, cache.protectedSizeBytes());
+    for (uint32_t i(10); i < 100; i++) {
+        cache.read(i);
+    }
+    for (uint32_t i(0); i < 4; i++) {
+        EXPECT_TRUE(cache.hasKey(i));
+    }
+    EXPECT_FALSE(cache.hasKey(10));
+    EXPECT_TRUE(cache.hasKey(99));
+    EXPECT_GREATER(cache.getEvict(), 0u);
+    EXPECT_LESS_EQUAL(cache.sizeBytes(), 810u);
+}
+
+TEST("require that protected segment demotes least recently used object when full") {
+    B m;
+    for (uint32_t i(0); i < 10; i++) {
+        m[i] = "a";
+    }
+    cache< CacheParam<P, B, zero<uint32_t>, size<string> > > cache(m, -1);
+    cache.setProtectedCapacityBytes(162);
+    for (uint32_t i(0); i < 4; i++) {
+        cache.read(i);
+        cache.read(i);
+    }
+    EXPECT_EQUAL(4u, cache.size());
+    EXPECT_EQUAL(324u, cache.sizeBytes());
+    EXPECT_EQUAL(162u, cache.protectedSizeBytes());
+    EXPECT_EQUAL(4u, cache.getHit());
+    EXPECT_EQUAL(4u, cache.getMiss());
+    cache.read(0);
+    EXPECT_EQUAL(162u, cache.protectedSizeBytes());
+    EXPECT_EQUAL(0u, cache.getEvict());
+    cache.write(3, "bb");
+    EXPECT_EQUAL(325u, cache.sizeBytes());
+    EXPECT_EQUAL(163u, cache.protectedSizeBytes());
+    cache.invalidate(3);
+    EXPECT_EQUAL(243u, cache.sizeBytes());
+    EXPECT_EQUAL(81u, cache.protectedSizeBytes());
+    EXPECT_EQUAL(3u, cache.size());
+}
+
+using SizedParams = CacheParam<P, B, zero<uint32_t>, size<string> >;
+
+class KeyTrackingCache : public cache<SizedParams> {
+public:
+    KeyTrackingCache(B & b, size_t maxBytes) : cache<SizedParams>(b, maxBytes), _keys() { }
+    std::set<uint32_t> _keys;
+private:
+    void onInsert(const uint32_t & key) override { _keys.insert(key); }
+    void onRemove(const uint32_t & key) override { _keys.erase(key); }
+};
+
+TEST("require that insert and remove hooks follow objects between the segments") {
+    B m;
+    for (uint32_t i(0); i < 10; i++) {
+        m[i] = "a";
+    }
+    KeyTrackingCache cache(m, -1);
+    cache.setProtectedCapacityBytes(162);
+    for (uint32_t i(0); i < 3; i++) {
+        cache.read(i);
+        cache.read(i);
+    }
+    EXPECT_EQUAL(162u, cache.protectedSizeBytes());
+    EXPECT_TRUE(std::set<uint32_t>({0, 1, 2}) == cache._keys);
+    cache.invalidate(2);
+    EXPECT_TRUE(std::set<uint32_t>({0, 1}) == cache._keys);
+    cache.invalidate(0);
+    EXPECT_TRUE(std::set<uint32_t>({1}) == cache._keys);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -38,6 +38,13 @@ struct CacheParam : public P
  * Stuff is evicted from the cache if either number of elements or the accounted size passes the limits given.
  * The cache is thread safe by a single lock for accessing the underlying Lru. In addition a striped locking with
  * 64 locks chosen by the hash of the key to enable a single fetch for any element required by multiple readers.
+ *
+ * Optionally a protected segment can be enabled with @ref setProtectedCapacityBytes, making it a segmented LRU.
+ * New objects are then inserted into the probationary segment, and only promoted to the protected segment when
+ * read again. When the protected segment is full, its least recently used object is demoted back to the
+ * probationary segment. Eviction only happens from the probationary segment, so a scan touching each object
+ * once will not flush the frequently used ones. The insert/remove hooks are called for both segments, so an
+ * object moving between them is seen as removed and inserted again.
  */
 template< typename P >
 class cache : private lrucache_map<P>
@@ -73,11 +80,19 @@ public:
 
     cache & setCapacityBytes(size_t sz);
 
+    /**
+     * Set how many of the bytes can be used by objects that have been read more than once.
+     * Default is 0, which disables the protected segment.
+     */
+    cache & setProtectedCapacityBytes(size_t sz);
+
     size_t capacity()                  const { return Lru::capacity(); }
     size_t capacityBytes()             const { return _maxBytes; }
-    size_t size()                      const { return Lru::size(); }
+    size_t protectedCapacityBytes()    const { return _maxProtectedBytes; }
+    size_t size()                      const { return Lru::size() + _protected.size(); }
     size_t sizeBytes()                 const { return _sizeBytes; }
-    bool empty()                       const { return Lru::empty(); }
+    size_t protectedSizeBytes()        const { return _protectedSizeBytes; }
+    bool empty()                       const { return Lru::empty() && _protected.empty(); }
 
     /**
      * This simply erases the object.
@@ -118,6 +133,7 @@ public:
     size_t        getErase() const { return _erase; }
     size_t   getInvalidate() const { return _invalidate; }
     size_t       getlookup() const { return _lookup; }
+    size_t        getEvict() const { return _evict; }
 
 protected:
     vespalib::LockGuard getGuard();
@@ -125,6 +141,15 @@ protected:
     bool hasKey(const vespalib::LockGuard & guard, const K & key) const;
     bool hasLock() const;
 private:
+    class ProtectedSegment : public lrucache_map<P> {
+    public:
+        ProtectedSegment(cache & owner) : lrucache_map<P>(lrucache_map<P>::UNLIMITED), _owner(owner) { }
+        bool removeOldest(const value_type & v) override { return _owner.demoteOldest(v); }
+        void onRemove(const K & key) override { _owner.onRemove(key); }
+        void onInsert(const K & key) override { _owner.onInsert(key); }
+    private:
+        cache & _owner;
+    };
     /**
      * Called when an object is inserted, to see if the LRU should be removed.
      * Default is to obey the maxsize given in constructor.
@@ -132,6 +157,16 @@ private:
      * on the real size of the object pointed to.
      */
     bool removeOldest(const value_type & v) override;
+    /**
+     * Called when an object is inserted in the protected segment, moving the least recently
+     * used one to the probationary segment when the protected segment is full.
+     */
+    bool demoteOldest(const value_type & v);
+    /**
+     * Looks up the object in both segments, promoting it if found in the probationary segment.
+     * Caller must hold the hash lock.
+     */
+    bool lookup(const K & key, V & value);
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
     vespalib::Lock & getLock(const K & k) {
         size_t h(_hasher(k));
@@ -142,6 +177,8 @@ private:
     SizeV               _sizeV;
     size_t              _maxBytes;
     size_t              _sizeBytes;
+    size_t              _maxProtectedBytes;
+    size_t              _protectedSizeBytes;
     mutable size_t      _hit;
     mutable size_t      _miss;
     std::atomic<size_t> _noneExisting;
@@ -152,6 +189,8 @@ private:
     mutable size_t      _erase;
     mutable size_t      _invalidate;
     mutable size_t      _lookup;
+    size_t              _evict;
+    ProtectedSegment    _protected;
     BackingStore      & _store;
     vespalib::Lock      _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
@@ -27,6 +27,13 @@ cache<P>::setCapacityBytes(size_t sz) {
     return *this;
 }
 
+template< typename P >
+cache<P> &
+cache<P>::setProtectedCapacityBytes(size_t sz) {
+    _maxProtectedBytes = sz;
+    return *this;
+}
+
 template< typename P >
 void
 cache<P>::invalidate(const K & key) {
@@ -55,6 +62,8 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     Lru(Lru::UNLIMITED),
     _maxBytes(maxBytes),
     _sizeBytes(0),
+    _maxProtectedBytes(0),
+    _protectedSizeBytes(0),
     _hit(0),
     _miss(0),
     _noneExisting(0),
@@ -65,6 +74,8 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _erase(0),
     _invalidate(0),
     _lookup(0),
+    _evict(0),
+    _protected(*this),
     _store(b)
 { }
 
@@ -74,10 +85,44 @@ cache<P>::removeOldest(const value_type & v) {
     bool remove(Lru::removeOldest(v) || (sizeBytes() >= capacityBytes()));
     if (remove) {
         _sizeBytes -= calcSize(v.first, v.second._value);
+        _evict++;
     }
     return remove;
 }
 
+template< typename P >
+bool
+cache<P>::demoteOldest(const value_type & v) {
+    bool demote(_protectedSizeBytes > _maxProtectedBytes);
+    if (demote) {
+        _protectedSizeBytes -= calcSize(v.first, v.second._value);
+        Lru::insert(v.first, v.second._value);
+    }
+    return demote;
+}
+
+template< typename P >
+bool
+cache<P>::lookup(const K & key, V & value) {
+    if (_protected.hasKey(key)) {
+        value = V(_protected[key]);
+        return true;
+    }
+    if ( ! Lru::hasKey(key)) {
+        return false;
+    }
+    if (_maxProtectedBytes == 0) {
+        value = V((*this)[key]);
+        return true;
+    }
+    V promoted(std::move((*this)[key]));
+    Lru::erase(key);
+    value = V(promoted);
+    _protectedSizeBytes += calcSize(key, value);
+    _protected.insert(key, std::move(promoted));
+    return true;
+}
+
 template< typename P >
 vespalib::LockGuard
 cache<P>::getGuard() {
@@ -88,11 +133,12 @@ template< typename P >
 typename P::Value
 cache<P>::read(const K & key)
 {
+    V value;
     {
         vespalib::LockGuard guard(_hashLock);
-        if (Lru::hasKey(key)) {
+        if (lookup(key, value)) {
             _hit++;
-            return (*this)[key];
+            return value;
         } else {
             _miss++;
         }
@@ -101,13 +147,12 @@ cache<P>::read(const K & key)
     vespalib::LockGuard storeGuard(getLock(key));
     {
         vespalib::LockGuard guard(_hashLock);
-        if (Lru::hasKey(key)) {
+        if (lookup(key, value)) {
             // Somebody else just fetched it ahead of me.
             _race++;
-            return (*this)[key];
+            return value;
         }
     }
-    V value;
     if (_store.read(key, value)) {
         vespalib::LockGuard guard(_hashLock);
         Lru::insert(key, value);
@@ -125,18 +170,24 @@ cache<P>::write(const K & key, V value)
 {
     size_t newSize = calcSize(key, value);
     vespalib::LockGuard storeGuard(getLock(key));
+    _store.write(key, value);
     {
         vespalib::LockGuard guard(_hashLock);
-        if (Lru::hasKey(key)) {
-            _sizeBytes -= calcSize(key, (*this)[key]);
+        if (_protected.hasKey(key)) {
+            V & existing = _protected[key];
+            size_t oldSize = calcSize(key, existing);
+            _sizeBytes -= oldSize;
+            _protectedSizeBytes -= oldSize;
+            existing = std::move(value);
+            _protectedSizeBytes += newSize;
             _update++;
+        } else {
+            if (Lru::hasKey(key)) {
+                _sizeBytes -= calcSize(key, (*this)[key]);
+                _update++;
+            }
+            (*this)[key] = std::move(value);
         }
-    }
-
-    _store.write(key, value);
-    {
-        vespalib::LockGuard guard(_hashLock);
-        (*this)[key] = std::move(value);
         _sizeBytes += newSize;
         _write++;
     }
@@ -157,7 +208,13 @@ cache<P>::invalidate(const vespalib::LockGuard & guard, const K & key)
 {
     assert(guard.locks(_hashLock));
     (void) guard;
-    if (Lru::hasKey(key)) {
+    if (_protected.hasKey(key)) {
+        size_t sz = calcSize(key, _protected.get(key));
+        _sizeBytes -= sz;
+        _protectedSizeBytes -= sz;
+        _invalidate++;
+        _protected.erase(key);
+    } else if (Lru::hasKey(key)) {
         _sizeBytes -= calcSize(key, (*this)[key]);
         _invalidate++;
         Lru::erase(key);
@@ -171,7 +228,7 @@ cache<P>::hasKey(const vespalib::LockGuard & guard, const K & key) const
     (void) guard;
     assert(guard.locks(_hashLock));
     _lookup++;
-    return Lru::hasKey(key);
+    return Lru::hasKey(key) || _protected.hasKey(key);
 }
 
 }
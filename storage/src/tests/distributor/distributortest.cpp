@@ -45,6 +45,7 @@ class Distributor_Test : public CppUnit::TestFixture,
     CPPUNIT_TEST(testPriorityConfigIsPropagatedToDistributorConfiguration);
     CPPUNIT_TEST(testNoDbResurrectionForBucketNotOwnedInPendingState);
     CPPUNIT_TEST(testAddedDbBucketsWithoutGcTimestampImplicitlyGetCurrentTime);
+    CPPUNIT_TEST(bucketIsQueuedForPrioritizationOnlyWhenItsReplicasChange);
     CPPUNIT_TEST(mergeStatsAreAccumulatedDuringDatabaseIteration);
     CPPUNIT_TEST(statsGeneratedForPreemptedOperations);
     CPPUNIT_TEST(hostInfoReporterConfigIsPropagatedToReporter);
@@ -84,6 +85,7 @@ protected:
     void testPriorityConfigIsPropagatedToDistributorConfiguration();
     void testNoDbResurrectionForBucketNotOwnedInPendingState();
     void testAddedDbBucketsWithoutGcTimestampImplicitlyGetCurrentTime();
+    void bucketIsQueuedForPrioritizationOnlyWhenItsReplicasChange();
     void mergeStatsAreAccumulatedDuringDatabaseIteration();
     void statsGeneratedForPreemptedOperations();
     void hostInfoReporterConfigIsPropagatedToReporter();
@@ -134,6 +136,14 @@ private:
         _distributor->enableNextConfig();
     }
 
+    size_t changedBucketCount() const {
+        return _distributor->_scanner->getChangedBucketCount();
+    }
+
+    void prioritizeAllChangedBuckets() {
+        _distributor->_scanner->prioritizeChangedBuckets(changedBucketCount());
+    }
+
     auto currentReplicaCountingMode() const noexcept {
         return _distributor->_bucketDBMetricUpdater
                 .getMinimumReplicaCountingMode();
@@ -617,6 +627,38 @@ Distributor_Test::testAddedDbBucketsWithoutGcTimestampImplicitlyGetCurrentTime()
     CPPUNIT_ASSERT_EQUAL(uint32_t(101234), e->getLastGarbageCollectionTime());
 }
 
+void
+Distributor_Test::bucketIsQueuedForPrioritizationOnlyWhenItsReplicasChange()
+{
+    setupDistributor(Redundancy(2), NodeCount(10), "storage:2 distributor:1");
+    prioritizeAllChangedBuckets();
+    document::Bucket bucket(makeDocumentBucket(document::BucketId(16, 7654)));
+
+    std::vector<BucketCopy> copies;
+    copies.emplace_back(1234, 0, api::BucketInfo(0x567, 1, 2));
+    getExternalOperationHandler().updateBucketDatabase(bucket, copies,
+                                    DatabaseUpdate::CREATE_IF_NONEXISTING);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), changedBucketCount());
+    prioritizeAllChangedBuckets();
+
+    // Bucket info that is already known does not queue the bucket again
+    getExternalOperationHandler().updateBucketDatabase(bucket, copies,
+                                    DatabaseUpdate::CREATE_IF_NONEXISTING);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), changedBucketCount());
+
+    copies.clear();
+    copies.emplace_back(1235, 0, api::BucketInfo(0x568, 2, 3));
+    getExternalOperationHandler().updateBucketDatabase(bucket, copies,
+                                    DatabaseUpdate::CREATE_IF_NONEXISTING);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), changedBucketCount());
+    prioritizeAllChangedBuckets();
+
+    // Removing a node that has no replica of the bucket changes nothing
+    getExternalOperationHandler().removeNodesFromDB(bucket, toVector<uint16_t>(1));
+    CPPUNIT_ASSERT_EQUAL(size_t(0), changedBucketCount());
+    getExternalOperationHandler().removeNodesFromDB(bucket, toVector<uint16_t>(0));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), changedBucketCount());
+}
 
 void
 Distributor_Test::mergeStatsAreAccumulatedDuringDatabaseIteration()
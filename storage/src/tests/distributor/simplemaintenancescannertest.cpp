@@ -23,6 +23,7 @@ class SimpleMaintenanceScannerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testPendingMaintenanceOperationStatistics);
     CPPUNIT_TEST(perNodeMaintenanceStatsAreTracked);
     CPPUNIT_TEST(testReset);
+    CPPUNIT_TEST(changedBucketsArePrioritizedWithoutScanning);
     CPPUNIT_TEST_SUITE_END();
 
     using PendingStats = SimpleMaintenanceScanner::PendingMaintenanceStats;
@@ -48,6 +49,7 @@ public:
     void testPendingMaintenanceOperationStatistics();
     void perNodeMaintenanceStatsAreTracked();
     void testReset();
+    void changedBucketsArePrioritizedWithoutScanning();
 
     void setUp() override;
 };
@@ -241,4 +243,36 @@ SimpleMaintenanceScannerTest::perNodeMaintenanceStatsAreTracked()
     }
 }
 
+void
+SimpleMaintenanceScannerTest::changedBucketsArePrioritizedWithoutScanning()
+{
+    addBucketToDb(1);
+    addBucketToDb(2);
+    addBucketToDb(3);
+
+    document::Bucket bucket3(makeBucketSpace(), BucketId(16, 3));
+    document::Bucket bucket1(makeBucketSpace(), BucketId(16, 1));
+    _scanner->markBucketChanged(bucket3);
+    _scanner->markBucketChanged(bucket1);
+    _scanner->markBucketChanged(bucket3);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _scanner->getChangedBucketCount());
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _scanner->prioritizeChangedBuckets(1));
+    std::string expected("PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000003)), pri VERY_HIGH)\n");
+    CPPUNIT_ASSERT_EQUAL(expected, _priorityDb->toString());
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _scanner->prioritizeChangedBuckets(10));
+    expected = "PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000001)), pri VERY_HIGH)\n"
+               "PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000003)), pri VERY_HIGH)\n";
+    CPPUNIT_ASSERT_EQUAL(expected, _priorityDb->toString());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _scanner->getChangedBucketCount());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _scanner->prioritizeChangedBuckets(10));
+
+    // Out of band prioritization must not be counted as part of the scan.
+    std::string expectedEmpty("delete bucket: 0, merge bucket: 0, "
+                              "split bucket: 0, join bucket: 0, "
+                              "set bucket state: 0, garbage collection: 0");
+    CPPUNIT_ASSERT_EQUAL(expectedEmpty, stringifyGlobalPendingStats(_scanner->getPendingMaintenanceStats()));
+}
+
 }
@@ -1445,6 +1445,35 @@ MergeHandlerTest::testRemoveFromDiff()
         CPPUNIT_ASSERT(status.removeFromDiff(applyDiff, 0x7));
         CPPUNIT_ASSERT_EQUAL(size_t(2), status.diff.size());
     }
+
+    status.diff.clear();
+    for (uint32_t i = 0; i < 10; ++i) {
+        api::GetBucketDiffCommand::Entry e;
+        e._timestamp = 1000 + i;
+        e._flags = 0x1;
+        e._hasMask = 0x1;
+        status.diff.push_back(e);
+    }
+
+    {
+        // Removing interleaved entries must keep the remaining ones in
+        // timestamp order.
+        std::vector<api::ApplyBucketDiffCommand::Entry> applyDiff(3);
+        applyDiff[0]._entry._timestamp = 1001;
+        applyDiff[1]._entry._timestamp = 1004;
+        applyDiff[2]._entry._timestamp = 1009;
+        for (auto& e : applyDiff) {
+            e._entry._flags = 0x1;
+            e._entry._hasMask = 0x7;
+        }
+
+        CPPUNIT_ASSERT(status.removeFromDiff(applyDiff, 0x7));
+        CPPUNIT_ASSERT_EQUAL(size_t(7), status.diff.size());
+        std::vector<uint64_t> expected({1000, 1002, 1003, 1005, 1006, 1007, 1008});
+        for (uint32_t i = 0; i < expected.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(expected[i], uint64_t(status.diff[i]._timestamp));
+        }
+    }
 }
 
 void
@@ -19,6 +19,14 @@ LOG_SETUP(".distributor-main");
 
 namespace storage::distributor {
 
+namespace {
+
+// Bounds the time spent per tick re-prioritizing buckets whose replicas
+// changed, so that a burst of changes cannot starve client operations.
+constexpr size_t MaxChangedBucketsPrioritizedPerTick = 64;
+
+}
+
 class Distributor::Status {
     const DelegatedStatusRequest& _request;
     vespalib::Monitor _monitor;
@@ -484,6 +492,11 @@ Distributor::recheckBucketInfo(uint16_t nodeIdx, const document::Bucket &bucket)
     _bucketDBUpdater.recheckBucketInfo(nodeIdx, bucket);
 }
 
+void
+Distributor::notifyBucketReplicasChanged(const document::Bucket &bucket) {
+    _scanner->markBucketChanged(bucket);
+}
+
 namespace {
 
 class MaintenanceChecker : public PendingMessageTracker::Checker
@@ -753,6 +766,14 @@ Distributor::scanAllBuckets()
     while (!scanNextBucket().isDone()) {}
 }
 
+void
+Distributor::prioritizeChangedBuckets()
+{
+    if (_scanner->prioritizeChangedBuckets(MaxChangedBucketsPrioritizedPerTick) != 0) {
+        signalWorkWasDone();
+    }
+}
+
 MaintenanceScanner::ScanResult
 Distributor::scanNextBucket()
 {
@@ -804,6 +825,7 @@ Distributor::doNonCriticalTick(framework::ThreadIndex)
     handleStatusRequests();
     startExternalOperations();
     if (!initializing()) {
+        prioritizeChangedBuckets();
         scanNextBucket();
         startNextMaintenanceOperation();
         if (isInRecoveryMode()) {
@@ -92,6 +92,8 @@ public:
 
     void recheckBucketInfo(uint16_t nodeIdx, const document::Bucket &bucket) override;
 
+    void notifyBucketReplicasChanged(const document::Bucket &bucket) override;
+
     bool handleReply(const std::shared_ptr<api::StorageReply>& reply) override;
 
     // StatusReporter implementation
@@ -212,6 +214,7 @@ private:
      */
     void updateInternalMetricsForCompletedScan();
     void scanAllBuckets();
+    void prioritizeChangedBuckets();
     MaintenanceScanner::ScanResult scanNextBucket();
     void enableNextConfig();
     void fetchStatusRequests();
@@ -169,8 +169,10 @@ DistributorComponent::removeNodesFromDB(const document::Bucket &bucket,
     BucketDatabase::Entry dbentry = bucketSpace.getBucketDatabase().get(bucket.getBucketId());
 
     if (dbentry.valid()) {
+        bool removedAny = false;
         for (uint32_t i = 0; i < nodes.size(); ++i) {
             if (dbentry->removeNode(nodes[i])) {
+                removedAny = true;
                 LOG(debug,
                 "Removed node %d from bucket %s. %u copies remaining",
                     nodes[i],
@@ -189,6 +191,9 @@ DistributorComponent::removeNodesFromDB(const document::Bucket &bucket,
 
             bucketSpace.getBucketDatabase().remove(bucket.getBucketId());
         }
+        if (removedAny) {
+            _distributor.notifyBucketReplicasChanged(bucket);
+        }
     }
 }
 
@@ -239,7 +244,10 @@ DistributorComponent::updateBucketDatabase(
         return;
     }
 
-    if (!dbentry.valid()) {
+    // Only buckets whose replicas actually change need to be re-prioritized.
+    const bool created = !dbentry.valid();
+    const BucketInfo infoBefore(created ? BucketInfo() : dbentry.getBucketInfo());
+    if (created) {
         if (updateFlags & DatabaseUpdate::CREATE_IF_NONEXISTING) {
             dbentry = BucketDatabase::Entry(bucket.getBucketId(), BucketInfo());
         } else {
@@ -282,9 +290,13 @@ DistributorComponent::updateBucketDatabase(
     if (dbentry->getNodeCount() == 0) {
         LOG(warning, "all nodes in changedNodes set (size %zu) are down, removing dbentry", changedNodes.size());
         bucketSpace.getBucketDatabase().remove(bucket.getBucketId());
+        _distributor.notifyBucketReplicasChanged(bucket);
         return;
     }
     bucketSpace.getBucketDatabase().update(dbentry);
+    if (created || !(dbentry.getBucketInfo() == infoBefore)) {
+        _distributor.notifyBucketReplicasChanged(bucket);
+    }
 }
 
 void
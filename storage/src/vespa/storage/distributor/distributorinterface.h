@@ -32,6 +32,13 @@ public:
      */
     virtual void recheckBucketInfo(uint16_t nodeIdx, const document::Bucket &bucket) = 0;
 
+    /**
+     * Notifies that the set of replicas or their bucket info has changed
+     * for the given bucket, so that it may be re-prioritized for
+     * maintenance ahead of the regular database scan.
+     */
+    virtual void notifyBucketReplicasChanged(const document::Bucket &bucket) = 0;
+
     virtual bool handleReply(const std::shared_ptr<api::StorageReply>& reply) = 0;
 
     /**
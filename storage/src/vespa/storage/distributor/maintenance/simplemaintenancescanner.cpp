@@ -44,6 +44,32 @@ SimpleMaintenanceScanner::scanNext()
     }
 }
 
+void
+SimpleMaintenanceScanner::markBucketChanged(const document::Bucket &bucket)
+{
+    if (_changedBucketSet.insert(bucket).second) {
+        _changedBuckets.push_back(bucket);
+    }
+}
+
+size_t
+SimpleMaintenanceScanner::prioritizeChangedBuckets(size_t maxBuckets)
+{
+    // Per-node stats are only gathered by full scans, so don't let out of
+    // band prioritization count the same bucket twice.
+    NodeMaintenanceStatsTracker ignoredStats;
+    size_t processed = 0;
+    while (!_changedBuckets.empty() && (processed < maxBuckets)) {
+        document::Bucket bucket(_changedBuckets.front());
+        _changedBuckets.pop_front();
+        _changedBucketSet.erase(bucket);
+        MaintenancePriorityAndType pri(_priorityGenerator.prioritize(bucket, ignoredStats));
+        _bucketPriorityDb.setPriority(PrioritizedBucket(bucket, pri.getPriority().getPriority()));
+        ++processed;
+    }
+    return processed;
+}
+
 void
 SimpleMaintenanceScanner::reset()
 {
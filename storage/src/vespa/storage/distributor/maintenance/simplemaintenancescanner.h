@@ -6,6 +6,8 @@
 #include "maintenanceprioritygenerator.h"
 #include "node_maintenance_stats_tracker.h"
 #include <vespa/storage/distributor/distributor_bucket_space_repo.h>
+#include <deque>
+#include <unordered_set>
 
 namespace storage {
 namespace distributor {
@@ -35,6 +37,10 @@ private:
     DistributorBucketSpaceRepo::BucketSpaceMap::const_iterator _bucketSpaceItr;
     document::BucketId _bucketCursor;
     PendingMaintenanceStats _pendingMaintenance;
+    // Buckets whose replica state changed since they were last prioritized,
+    // in the order the changes were observed.
+    std::deque<document::Bucket> _changedBuckets;
+    std::unordered_set<document::Bucket, document::Bucket::hash> _changedBucketSet;
 
     void countBucket(document::BucketSpace bucketSpace, const BucketInfo &info);
 public:
@@ -51,6 +57,23 @@ public:
     // TODO: move out into own interface!
     void prioritizeBucket(const document::Bucket &id);
 
+    /**
+     * Queues a bucket whose replica state has changed, such that it gets
+     * re-prioritized without waiting for the round-robin scan to reach it.
+     * A bucket that is already queued is not queued again.
+     */
+    void markBucketChanged(const document::Bucket &bucket);
+
+    /**
+     * Re-prioritizes at most maxBuckets of the buckets queued through
+     * markBucketChanged(), oldest first. Buckets no longer needing
+     * maintenance are cleared from the priority database. Returns the
+     * number of buckets processed.
+     */
+    size_t prioritizeChangedBuckets(size_t maxBuckets);
+
+    size_t getChangedBucketCount() const { return _changedBuckets.size(); }
+
     const PendingMaintenanceStats& getPendingMaintenanceStats() const {
         return _pendingMaintenance;
     }
@@ -169,6 +169,9 @@ FileStorThreadMetrics::FileStorThreadMetrics(const std::string& name, const std:
             "current node.", this),
       mergeAverageDataReceivedNeeded("mergeavgdatareceivedneeded", {}, "Amount of data transferred from previous node "
                                      "in chain that we needed to apply locally.", this),
+      mergeDataWriteThroughput("mergedatawritethroughput", {},
+            "Number of bytes per second written to current node when "
+            "applying data received in a merge step.", this),
       batchingSize("batchingsize", {}, "Number of operations batched per bucket (only counts "
                    "batches of size > 1)", this)
 { }
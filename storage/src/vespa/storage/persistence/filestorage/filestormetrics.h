@@ -108,6 +108,7 @@ struct FileStorThreadMetrics : public metrics::MetricSet
     metrics::DoubleAverageMetric mergeDataReadLatency;
     metrics::DoubleAverageMetric mergeDataWriteLatency;
     metrics::DoubleAverageMetric mergeAverageDataReceivedNeeded;
+    metrics::DoubleAverageMetric mergeDataWriteThroughput;
     metrics::LongAverageMetric batchingSize;
 
     FileStorThreadMetrics(const std::string& name, const std::string& desc, const metrics::LoadTypeSet& lt);
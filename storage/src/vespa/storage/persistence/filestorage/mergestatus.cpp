@@ -22,62 +22,60 @@ MergeStatus::removeFromDiff(
         const std::vector<api::ApplyBucketDiffCommand::Entry>& part,
         uint16_t hasMask)
 {
+    // Both the diff and the part are sorted on timestamp, so we do a single
+    // merging pass over them, compacting kept diff entries towards the front
+    // as we go. Erasing entries one by one from the middle of the deque would
+    // make every merge round linear in the remaining diff size per entry.
     std::deque<api::GetBucketDiffCommand::Entry>::iterator it(diff.begin());
+    std::deque<api::GetBucketDiffCommand::Entry>::iterator out(diff.begin());
     std::vector<api::ApplyBucketDiffCommand::Entry>::const_iterator it2(
             part.begin());
     bool altered = false;
-    // We expect part array to be sorted in the same order as in the diff,
-    // and that all entries in the part should exist in the source list.
-    while (it != diff.end() && it2 != part.end()) {
-        if (it->_timestamp != it2->_entry._timestamp) {
-            ++it;
-        } else {
-            break;
+    for (; it != diff.end(); ++it) {
+        if (it2 == part.end() || it->_timestamp != it2->_entry._timestamp) {
+            if (out != it) {
+                *out = std::move(*it);
+            }
+            ++out;
+            continue;
         }
-    }
-
-    // Iterate and match entries in diff.
-    while (it != diff.end() && it2 != part.end()) {
-        if (it->_timestamp != it2->_entry._timestamp) {
-            ++it;
+        // It is legal for an apply bucket diff to not fill all entries, so
+        // only remove it if it was actually transferred to all copies this
+        // time around, or if no copies have that doc anymore. (Can happen
+        // due to reverting or corruption)
+        if (it2->_entry._hasMask == hasMask
+            || it2->_entry._hasMask == 0)
+        {
+            if (it2->_entry._hasMask == 0) {
+                LOG(debug, "Merge entry %s no longer exists on any nodes",
+                    it2->toString().c_str());
+            }
+            // Timestamp equal. Should really be the same entry. If not
+            // though, there is nothing we can do but accept it.
+            if (!(*it == it2->_entry)) {
+                LOG(warning, "Merge retrieved entry %s for entry %s but "
+                             "these do not match.",
+                    it2->toString().c_str(), it->toString().c_str());
+            }
+            altered = true;
         } else {
-            // It is legal for an apply bucket diff to not fill all entries, so
-            // only remove it if it was actually transferred to all copies this
-            // time around, or if no copies have that doc anymore. (Can happen
-            // due to reverting or corruption)
-            if (it2->_entry._hasMask == hasMask
-                || it2->_entry._hasMask == 0)
-            {
-                if (it2->_entry._hasMask == 0) {
-                    LOG(debug, "Merge entry %s no longer exists on any nodes",
-                        it2->toString().c_str());
-                }
-                // Timestamp equal. Should really be the same entry. If not
-                // though, there is nothing we can do but accept it.
-                if (!(*it == it2->_entry)) {
-                    LOG(warning, "Merge retrieved entry %s for entry %s but "
-                                 "these do not match.",
-                        it2->toString().c_str(), it->toString().c_str());
-                }
-                it = diff.erase(it);
-                altered = true;
-            } else if (it2->_entry._hasMask != it->_hasMask) {
+            if (it2->_entry._hasMask != it->_hasMask) {
                 // Hasmasks have changed, meaning bucket contents changed on
                 // one or more of the nodes during merging.
                 altered = true;
                 it->_hasMask = it2->_entry._hasMask;
             }
-            ++it2;
+            if (out != it) {
+                *out = std::move(*it);
+            }
+            ++out;
         }
+        ++it2;
     }
+    diff.erase(out, diff.end());
     if (it2 != part.end()) {
-        uint32_t counter = 0;
-        while (it2 != part.end()) {
-            ++it2;
-            ++counter;
-        }
-        LOG(warning, "Apply bucket diff contained %u entries not existing in "
-                     "the request.", counter);
+        LOG(warning, "Apply bucket diff contained %zu entries not existing in "
+                     "the request.", size_t(part.end() - it2));
     }
 
     return altered;
@@ -606,6 +606,7 @@ MergeHandler::applyDiffLocally(
     LOG(spam, "Merge(%s): Applying data locally. Diff has %zu entries",
         bucket.toString().c_str(),
         diff.size());
+    framework::MilliSecTimer startTime(_env._component.getClock());
     uint32_t nodeMask = 1 << nodeIndex;
     uint32_t byteCount = 0;
     uint32_t addedCount = 0;
@@ -711,6 +712,12 @@ MergeHandler::applyDiffLocally(
 
     flushGuard.flush();
 
+    double elapsedMs = startTime.getElapsedTimeAsDouble();
+    if (byteCount != 0 && elapsedMs > 0) {
+        _env._metrics.mergeDataWriteThroughput.addValue(
+                byteCount * 1000.0 / elapsedMs);
+    }
+
     spi::BucketInfoResult infoResult(_spi.getBucketInfo(bucket));
     if (infoResult.getErrorCode() != spi::Result::NONE) {
         LOG(warning, "Failed to get bucket info for %s: %s",